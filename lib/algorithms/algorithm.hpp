@@ -3,12 +3,17 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <concept.hpp>
 #include <concepts>
+#include <cstddef>
 #include <functional>
 #include <iterator>
+#include <simd.hpp>
+#include <span>
 #include <stack.hpp>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <unordered_set>
 #include <utility>
 #include <vector.hpp>
@@ -442,6 +447,107 @@ void introsort(Iter startIter, Iter endIter, Compare compareFn = Compare()) {
 }
 } // namespace sort
 
+// Linear algorithms over a whole container. Segmented containers (Deque,
+// CircularBuffer, StaticCircularBuffer) are walked one contiguous run at a
+// time and contiguous ones (Vector, Array) as a single run, so the loops
+// run over plain spans instead of the containers' iterators and the
+// algorithms::simd kernels apply. Positions are indices from the front,
+// size() when nothing matches.
+template <typename Container>
+concept Segmentable =
+    concepts::Segmented<Container> || concepts::Contiguous<Container>;
+
+template <typename Container>
+using element_t =
+    std::remove_cvref_t<decltype(*std::declval<Container&>().begin())>;
+
+// calls fn with a std::span of every run of elements, front to back
+template <Segmentable Container, typename Fn>
+void for_each_segment(Container& container, Fn&& fn) {
+  if constexpr (concepts::Segmented<Container>) {
+    container.for_each_segment(fn);
+  } else if (container.size() > 0) {
+    fn(std::span{container.data(), container.size()});
+  }
+}
+
+template <Segmentable Container, typename Fn>
+void for_each(Container& container, Fn fn) {
+  for_each_segment(container, [&](auto segment) {
+    for (auto& element : segment) {
+      fn(element);
+    }
+  });
+}
+
+template <Segmentable Container>
+std::size_t find(const Container& container,
+                 const element_t<Container>& value) {
+  std::size_t index{};
+  bool found{false};
+  for_each_segment(container, [&](auto segment) {
+    if (found) {
+      return;
+    }
+    std::size_t i{simd::find(segment.data(), segment.size(), value)};
+    index += i;
+    found = i < segment.size();
+  });
+  return index;
+}
+
+template <Segmentable Container>
+std::size_t count(const Container& container,
+                  const element_t<Container>& value) {
+  std::size_t total{};
+  for_each_segment(container, [&](auto segment) {
+    total += simd::count(segment.data(), segment.size(), value);
+  });
+  return total;
+}
+
+namespace {
+template <bool Less, typename Container>
+std::size_t _extreme_element(const Container& container) {
+  std::size_t index{};
+  std::size_t best{};
+  const element_t<Container>* bestValue{nullptr};
+  for_each_segment(container, [&](auto segment) {
+    std::size_t i{Less ? simd::min_element(segment.data(), segment.size())
+                       : simd::max_element(segment.data(), segment.size())};
+    // ties keep the earlier run
+    if (!bestValue ||
+        (Less ? segment[i] < *bestValue : *bestValue < segment[i])) {
+      bestValue = &segment[i];
+      best = index + i;
+    }
+    index += segment.size();
+  });
+  return best;
+}
+} // namespace
+
+// index of the first smallest element, 0 when empty
+template <Segmentable Container>
+std::size_t min_element(const Container& container) {
+  return _extreme_element<true>(container);
+}
+
+// index of the first largest element, 0 when empty
+template <Segmentable Container>
+std::size_t max_element(const Container& container) {
+  return _extreme_element<false>(container);
+}
+
+// const containers only hand out read-only runs
+template <Segmentable Container>
+  requires(!std::is_const_v<Container>)
+void fill(Container& container, const element_t<Container>& value) {
+  for_each_segment(container, [&](auto segment) {
+    simd::fill(segment.data(), segment.size(), value);
+  });
+}
+
 namespace sudoku {
 
 class Sudoku {
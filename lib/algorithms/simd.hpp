@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// Linear search and bulk kernels over a plain array, vectorised for
+// arithmetic T with the compiler's vector extensions. The vector width
+// follows the target: 32 bytes with AVX2 (-mavx2, -march=native), 16 with
+// SSE2 (every x86-64), otherwise the scalar loops below. Other T always
+// take the scalar loops.
+// Each kernel handles whole vectors first and the remainder one element at
+// a time; loads are unaligned, so any pointer works.
+// Searches return an index, length when nothing matches. With NaNs
+// min_element / max_element return an unspecified but valid index.
+namespace algorithms::simd {
+
+#if defined(__AVX2__)
+inline constexpr std::size_t VECTOR_BYTES{32};
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+inline constexpr std::size_t VECTOR_BYTES{16};
+#else
+inline constexpr std::size_t VECTOR_BYTES{0};
+#endif
+
+template <typename T>
+inline constexpr bool IS_VECTORISED{VECTOR_BYTES > 0 &&
+                                    std::is_arithmetic_v<T> &&
+                                    !std::is_same_v<T, bool>};
+
+// index of the first element equal to value
+template <typename T>
+std::size_t find(const T* first, std::size_t length, const T& value);
+
+namespace detail {
+
+// a vector attribute on an alias template is lost in dependent contexts, a
+// member typedef keeps it
+template <typename T> struct VectorOf {
+  typedef T type
+      [[gnu::vector_size(VECTOR_BYTES ? VECTOR_BYTES : sizeof(T))]];
+};
+
+template <typename T> using Vector = typename VectorOf<T>::type;
+
+template <typename T>
+inline constexpr std::size_t LANES{VECTOR_BYTES / sizeof(T)};
+
+// where the whole vectors of length elements end, the rest is the tail
+template <typename T> std::size_t vectorEnd(std::size_t length) {
+  return length - length % LANES<T>;
+}
+
+template <typename T> Vector<T> load(const T* p) {
+  Vector<T> v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+template <typename T> void store(T* p, Vector<T> v) {
+  std::memcpy(p, &v, sizeof(v));
+}
+
+template <typename T> Vector<T> broadcast(T value) {
+  Vector<T> v;
+  for (std::size_t i{}; i < LANES<T>; ++i) {
+    v[i] = value;
+  }
+  return v;
+}
+
+// lanes of a comparison result: the signed integer as wide as T, all ones
+// where it holds
+template <typename T>
+using MaskLane = std::conditional_t<
+    sizeof(T) == 1, std::int8_t,
+    std::conditional_t<sizeof(T) == 2, std::int16_t,
+                       std::conditional_t<sizeof(T) == 4, std::int32_t,
+                                          std::int64_t>>>;
+
+template <typename T> using Mask = Vector<MaskLane<T>>;
+
+// true if any lane of a comparison result is set
+template <typename Mask> bool any(Mask mask) {
+  std::uint64_t words[sizeof(Mask) / sizeof(std::uint64_t)];
+  std::memcpy(words, &mask, sizeof(mask));
+  std::uint64_t merged{};
+  for (std::uint64_t word : words) {
+    merged |= word;
+  }
+  return merged != 0;
+}
+
+// the smallest (Less) or largest (!Less) lane
+template <bool Less, typename T> T reduce(Vector<T> v) {
+  T best{v[0]};
+  for (std::size_t i{1}; i < LANES<T>; ++i) {
+    if (Less ? v[i] < best : best < v[i]) {
+      best = v[i];
+    }
+  }
+  return best;
+}
+
+template <bool Less, typename T>
+std::size_t extreme_element(const T* first, std::size_t length) {
+  if (length == 0) {
+    return 0;
+  }
+  if constexpr (IS_VECTORISED<T>) {
+    if (length >= LANES<T>) {
+      // lane wise extremes, then the first element equal to the extreme
+      Vector<T> best{load(first)};
+      std::size_t i{LANES<T>};
+      for (std::size_t end{vectorEnd<T>(length)}; i < end; i += LANES<T>) {
+        Vector<T> v{load(first + i)};
+        best = (Less ? v < best : best < v) ? v : best;
+      }
+      T value{reduce<Less, T>(best)};
+      for (; i < length; ++i) {
+        if (Less ? first[i] < value : value < first[i]) {
+          value = first[i];
+        }
+      }
+      // a NaN compares false both ways, so it can stick in a lane and come
+      // out of reduce; find then misses it, leave that to the scalar loop
+      std::size_t found{find(first, length, value)};
+      if (value == value && found < length) {
+        return found;
+      }
+    }
+  }
+  std::size_t best{};
+  for (std::size_t i{1}; i < length; ++i) {
+    if (Less ? first[i] < first[best] : first[best] < first[i]) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+} // namespace detail
+
+template <typename T>
+std::size_t find(const T* first, std::size_t length, const T& value) {
+  std::size_t i{};
+  if constexpr (IS_VECTORISED<T>) {
+    using namespace detail;
+    Vector<T> needle{broadcast(value)};
+    for (std::size_t end{vectorEnd<T>(length)}; i < end; i += LANES<T>) {
+      if (any(load(first + i) == needle)) {
+        break;
+      }
+    }
+  }
+  for (; i < length; ++i) {
+    if (first[i] == value) {
+      return i;
+    }
+  }
+  return length;
+}
+
+// number of elements equal to value
+template <typename T>
+std::size_t count(const T* first, std::size_t length, const T& value) {
+  std::size_t total{};
+  std::size_t i{};
+  if constexpr (IS_VECTORISED<T>) {
+    using namespace detail;
+    // matching lanes are -1, subtracting them counts up; flush before a lane
+    // can overflow
+    constexpr std::size_t flushEvery{std::min<std::size_t>(
+        std::numeric_limits<MaskLane<T>>::max(), 1 << 16)};
+    Vector<T> needle{broadcast(value)};
+    std::size_t end{vectorEnd<T>(length)};
+    while (i < end) {
+      Mask<T> lanes{};
+      std::size_t flushAt{std::min(end, i + flushEvery * LANES<T>)};
+      for (; i < flushAt; i += LANES<T>) {
+        lanes -= load(first + i) == needle;
+      }
+      for (std::size_t lane{}; lane < LANES<T>; ++lane) {
+        total += static_cast<std::size_t>(lanes[lane]);
+      }
+    }
+  }
+  for (; i < length; ++i) {
+    total += first[i] == value;
+  }
+  return total;
+}
+
+// index of the first smallest element, 0 when empty
+template <typename T>
+std::size_t min_element(const T* first, std::size_t length) {
+  return detail::extreme_element<true>(first, length);
+}
+
+// index of the first largest element, 0 when empty
+template <typename T>
+std::size_t max_element(const T* first, std::size_t length) {
+  return detail::extreme_element<false>(first, length);
+}
+
+template <typename T> void fill(T* first, std::size_t length, const T& value) {
+  std::size_t i{};
+  if constexpr (IS_VECTORISED<T>) {
+    using namespace detail;
+    Vector<T> v{broadcast(value)};
+    for (std::size_t end{vectorEnd<T>(length)}; i < end; i += LANES<T>) {
+      store(first + i, v);
+    }
+  }
+  for (; i < length; ++i) {
+    first[i] = value;
+  }
+}
+
+} // namespace algorithms::simd
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <utility>
+
+// Bump-pointer arena. Memory is handed out from large regions and never
+// given back one object at a time: deallocate is a no-op and everything is
+// returned at once by release() (or the destructor). Regions double in size
+// as the arena grows so a big build touches the system allocator only
+// O(log n) times.
+// Not thread-safe, same as the containers that use it.
+class MonotonicArena {
+  struct Region {
+    Region* _next{nullptr};
+    std::size_t _size{};
+  };
+
+  inline static constexpr std::size_t DEFAULT_REGION_SIZE{64 * 1024};
+
+  Region* _regions{nullptr};
+  std::byte* _cursor{nullptr};
+  std::byte* _end{nullptr};
+  std::size_t _nextRegionSize{DEFAULT_REGION_SIZE};
+  std::size_t _bytesAllocated{};
+  std::size_t _regionCount{};
+
+public:
+  explicit MonotonicArena(std::size_t initialRegionSize = DEFAULT_REGION_SIZE)
+      : _nextRegionSize{std::max<std::size_t>(initialRegionSize, 64)} {};
+  ~MonotonicArena() { release(); };
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  void* allocate(std::size_t bytes,
+                 std::size_t alignment = alignof(std::max_align_t)) {
+    std::byte* p{align_up(_cursor, alignment)};
+    if (!_cursor || p + bytes > _end) {
+      add_region(bytes + alignment);
+      p = align_up(_cursor, alignment);
+    }
+    _cursor = p + bytes;
+    _bytesAllocated += bytes;
+    return p;
+  }
+
+  void deallocate(void*, std::size_t = 0) noexcept {};
+
+  // free every region at once, all memory handed out so far is invalid
+  // afterwards. The next region starts from the size of the largest one so a
+  // recurring batch of the same shape needs a single region.
+  void release() noexcept {
+    std::size_t largestRegion{};
+    while (_regions) {
+      Region* next{_regions->_next};
+      largestRegion = std::max(largestRegion, _regions->_size);
+      ::operator delete(_regions);
+      _regions = next;
+    }
+    _nextRegionSize = std::max(_nextRegionSize, largestRegion);
+    _cursor = nullptr;
+    _end = nullptr;
+    _bytesAllocated = 0;
+    _regionCount = 0;
+  }
+
+  std::size_t bytes_allocated() const noexcept { return _bytesAllocated; }
+  std::size_t region_count() const noexcept { return _regionCount; }
+
+private:
+  static std::byte* align_up(std::byte* p, std::size_t alignment) noexcept {
+    std::uintptr_t address{reinterpret_cast<std::uintptr_t>(p)};
+    address = (address + alignment - 1) & ~(alignment - 1);
+    return reinterpret_cast<std::byte*>(address);
+  }
+
+  void add_region(std::size_t minBytes) {
+    std::size_t size{std::max(_nextRegionSize, minBytes + sizeof(Region))};
+    Region* region{static_cast<Region*>(::operator new(size))};
+    region->_next = _regions;
+    region->_size = size;
+    _regions = region;
+    _cursor = reinterpret_cast<std::byte*>(region + 1);
+    _end = reinterpret_cast<std::byte*>(region) + size;
+    _nextRegionSize = size * 2;
+    ++_regionCount;
+  }
+};
+
+// Rebindable allocator adapter over a MonotonicArena.
+// The repo's containers default construct their allocator wherever they need
+// one (e.g. Node::operator new), so the arena cannot be passed in; instead
+// every ArenaAllocator sharing the same Tag draws from the same arena,
+// whatever T it has been rebound to. Use a distinct Tag per batch job:
+//
+//   struct BatchArena {};
+//   using Alloc = ArenaAllocator<int, BatchArena>;
+//   { trees::BPlusTree<int, int, 16, Alloc> tree; ... }
+//   Alloc::arena().release();
+//
+// Containers check is_monotonic and skip their per-node destruction walk when
+// the payload is trivially destructible.
+template <typename T, typename Tag = void> class ArenaAllocator {
+
+public:
+  using value_type = T;
+
+  using pointer = value_type*;
+  using const_pointer = const pointer;
+
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using rvalue_reference = value_type&&;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  inline static constexpr bool is_monotonic{true};
+
+  template <typename U> struct rebind {
+    using other = ArenaAllocator<U, Tag>;
+  };
+
+  ArenaAllocator(){};
+  ~ArenaAllocator(){};
+  ArenaAllocator(const ArenaAllocator&){};
+  template <typename U> ArenaAllocator(const ArenaAllocator<U, Tag>&) {}
+
+  // one arena per Tag, shared by every rebound allocator
+  static MonotonicArena& arena() { return ArenaAllocator<void, Tag>::arena(); }
+
+  // address
+  pointer address(reference r) { return &r; };
+  pointer address(const_reference r) const { return &r; };
+
+  // memory allocation
+  pointer allocate(size_type count = 1, const void* = 0) {
+    return static_cast<pointer>(arena().allocate(
+        std::max<size_type>(count, 1) * sizeof(value_type),
+        alignof(value_type)));
+  };
+  void deallocate(pointer, size_type = 0){};
+
+  // ctor / detor
+  void construct(pointer p) { new (p) value_type{}; };
+  void construct(pointer p, const_reference t) { new (p) value_type{t}; };
+  void construct(pointer p, rvalue_reference t) {
+    new (p) value_type{std::move(t)};
+  };
+  void destruct(pointer p) { p->~value_type(); };
+
+  bool operator==(ArenaAllocator const&) { return true; };
+  bool operator!=(ArenaAllocator const& a) { return !(*this == a); };
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+};
+
+template <typename Tag> class ArenaAllocator<void, Tag> {
+  using value_type = void;
+  using pointer = void*;
+  using const_pointer = const void*;
+
+public:
+  inline static constexpr bool is_monotonic{true};
+
+  template <class U> struct rebind {
+    using other = ArenaAllocator<U, Tag>;
+  };
+
+  static MonotonicArena& arena() {
+    static MonotonicArena instance{};
+    return instance;
+  }
+};
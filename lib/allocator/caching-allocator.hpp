@@ -0,0 +1,393 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <utility>
+
+// Size-class magazine cache in front of ::operator new.
+// Every thread keeps a small free list (magazine) per size class, so the
+// common allocate / deallocate pair never takes a lock or reaches the system
+// allocator. When a magazine overflows, half of it is handed to a shared
+// depot as one batch; an empty magazine takes a whole batch back from the
+// depot before falling back to the system. Blocks may be freed by a different
+// thread than the one that allocated them.
+//
+// Size classes are 16 bytes apart up to 128 bytes, then 4 per power of two
+// up to MAX_CACHED_SIZE. Bigger requests go straight to ::operator new.
+// Every block carries a small header with its size class so deallocate does
+// not need the original count.
+class MagazineCache {
+public:
+  struct Stats {
+    std::size_t hits{};    // served from the thread's magazine
+    std::size_t misses{};  // magazine was empty
+    std::size_t refills{}; // misses served by a batch from the depot
+    std::size_t flushes{}; // batches handed to the depot
+
+    double hit_rate() const noexcept {
+      std::size_t total{hits + misses};
+      return total ? static_cast<double>(hits) / static_cast<double>(total)
+                   : 0.0;
+    }
+
+    Stats& operator+=(const Stats& other) noexcept {
+      hits += other.hits;
+      misses += other.misses;
+      refills += other.refills;
+      flushes += other.flushes;
+      return *this;
+    }
+
+    friend Stats operator-(Stats a, const Stats& b) noexcept {
+      a.hits -= b.hits;
+      a.misses -= b.misses;
+      a.refills -= b.refills;
+      a.flushes -= b.flushes;
+      return a;
+    }
+  };
+
+  inline static constexpr std::size_t MAX_CACHED_SIZE{64 * 1024};
+  inline static constexpr std::size_t CLASS_COUNT{44};
+
+private:
+  struct alignas(std::max_align_t) Header {
+    std::size_t _sizeClass;
+    // only meaningful on the first block of a depot batch
+    std::size_t _batchSize;
+  };
+
+  // a free block reuses its payload to link into a magazine or the depot
+  struct FreeBlock {
+    FreeBlock* _next;
+    FreeBlock* _nextBatch;
+  };
+
+  struct Magazine {
+    FreeBlock* _head{nullptr};
+    std::size_t _count{};
+  };
+
+  struct DepotClass {
+    std::mutex _mutex{};
+    FreeBlock* _batches{nullptr};
+    // counters folded in by every thread that talked to this class
+    Stats _stats{};
+  };
+
+  struct Depot {
+    DepotClass _classes[CLASS_COUNT]{};
+  };
+
+  struct ThreadCache {
+    Magazine _magazines[CLASS_COUNT]{};
+    Stats _stats[CLASS_COUNT]{};
+    // part of _stats already folded into the depot
+    Stats _reported[CLASS_COUNT]{};
+
+    ThreadCache() = default;
+    ThreadCache(const ThreadCache&) = delete;
+    ThreadCache& operator=(const ThreadCache&) = delete;
+    ~ThreadCache() {
+      for (std::size_t sizeClass{}; sizeClass < CLASS_COUNT; ++sizeClass) {
+        return_magazine(*this, sizeClass);
+      }
+      _threadCacheDestroyed = true;
+    }
+  };
+
+  inline static constexpr std::size_t LARGE_CLASS{CLASS_COUNT};
+
+  // blocks freed by a thread-local destructor that runs after the thread's
+  // cache is gone are sent straight to the depot
+  inline static thread_local bool _threadCacheDestroyed{false};
+
+public:
+  inline static constexpr std::size_t HEADER_SIZE{sizeof(Header)};
+
+  static constexpr std::size_t size_class(std::size_t bytes) noexcept {
+    if (bytes <= 128) {
+      return bytes ? (bytes - 1) / 16 : 0;
+    }
+    std::size_t log{static_cast<std::size_t>(std::bit_width(bytes - 1)) - 1};
+    return 8 + (log - 7) * 4 + ((bytes - 1) >> (log - 2)) - 4;
+  }
+
+  static constexpr std::size_t class_size(std::size_t sizeClass) noexcept {
+    if (sizeClass < 8) {
+      return (sizeClass + 1) * 16;
+    }
+    std::size_t base{std::size_t{1} << (7 + (sizeClass - 8) / 4)};
+    return base + ((sizeClass - 8) % 4 + 1) * (base / 4);
+  }
+
+  // small classes keep more blocks per thread, big ones at least a few
+  static constexpr std::size_t
+  magazine_capacity(std::size_t sizeClass) noexcept {
+    return std::clamp<std::size_t>(32 * 1024 / class_size(sizeClass), 4, 64);
+  }
+
+  static constexpr std::size_t batch_size(std::size_t sizeClass) noexcept {
+    return magazine_capacity(sizeClass) / 2;
+  }
+
+  static void* allocate(std::size_t bytes) {
+    if (bytes > MAX_CACHED_SIZE) {
+      return system_allocate(bytes, LARGE_CLASS);
+    }
+    std::size_t sizeClass{size_class(bytes)};
+    ThreadCache* cache{thread_cache()};
+    if (!cache) {
+      return system_allocate(class_size(sizeClass), sizeClass);
+    }
+    Magazine& magazine{cache->_magazines[sizeClass]};
+    if (magazine._head) {
+      ++cache->_stats[sizeClass].hits;
+    } else {
+      ++cache->_stats[sizeClass].misses;
+      if (!refill(*cache, sizeClass)) {
+        return system_allocate(class_size(sizeClass), sizeClass);
+      }
+    }
+    FreeBlock* block{magazine._head};
+    magazine._head = block->_next;
+    --magazine._count;
+    return block;
+  }
+
+  static void deallocate(void* p) noexcept {
+    if (!p) {
+      return;
+    }
+    Header* header{header_of(p)};
+    std::size_t sizeClass{header->_sizeClass};
+    if (sizeClass == LARGE_CLASS) {
+      ::operator delete(header);
+      return;
+    }
+    FreeBlock* block{static_cast<FreeBlock*>(p)};
+    ThreadCache* cache{thread_cache()};
+    if (!cache) {
+      block->_next = nullptr;
+      push_batch(sizeClass, block, 1, nullptr);
+      return;
+    }
+    Magazine& magazine{cache->_magazines[sizeClass]};
+    if (magazine._count == magazine_capacity(sizeClass)) {
+      flush(*cache, sizeClass);
+    }
+    block->_next = magazine._head;
+    magazine._head = block;
+    ++magazine._count;
+  }
+
+  // hand every block cached by the calling thread back to the depot, e.g.
+  // before a worker goes idle for a long time
+  static void flush_thread_cache() noexcept {
+    if (ThreadCache* cache{thread_cache()}) {
+      for (std::size_t sizeClass{}; sizeClass < CLASS_COUNT; ++sizeClass) {
+        return_magazine(*cache, sizeClass);
+      }
+    }
+  }
+
+  // counters of the calling thread only
+  static Stats thread_stats(std::size_t sizeClass) noexcept {
+    ThreadCache* cache{thread_cache()};
+    return cache ? cache->_stats[sizeClass] : Stats{};
+  }
+
+  // counters of every thread. Other threads fold their counters in whenever
+  // they refill or flush and when they exit, so this lags behind busy threads
+  // that are still hitting their magazines.
+  static Stats global_stats(std::size_t sizeClass) {
+    DepotClass& depotClass{depot()._classes[sizeClass]};
+    std::lock_guard<std::mutex> lock{depotClass._mutex};
+    Stats total{depotClass._stats};
+    if (ThreadCache* cache{thread_cache()}) {
+      total += cache->_stats[sizeClass] - cache->_reported[sizeClass];
+    }
+    return total;
+  }
+
+private:
+  static Header* header_of(void* p) noexcept {
+    return reinterpret_cast<Header*>(static_cast<std::byte*>(p) -
+                                     HEADER_SIZE);
+  }
+
+  static void* system_allocate(std::size_t bytes, std::size_t sizeClass) {
+    Header* header{static_cast<Header*>(::operator new(HEADER_SIZE + bytes))};
+    header->_sizeClass = sizeClass;
+    return reinterpret_cast<std::byte*>(header) + HEADER_SIZE;
+  }
+
+  // never destroyed, containers with static storage may still free into it
+  // while the program shuts down
+  static Depot& depot() {
+    static Depot* instance{new Depot{}};
+    return *instance;
+  }
+
+  static ThreadCache* thread_cache() noexcept {
+    if (_threadCacheDestroyed) {
+      return nullptr;
+    }
+    thread_local ThreadCache cache{};
+    return &cache;
+  }
+
+  static void fold_stats(DepotClass& depotClass, ThreadCache* cache,
+                         std::size_t sizeClass) noexcept {
+    if (cache) {
+      depotClass._stats +=
+          cache->_stats[sizeClass] - cache->_reported[sizeClass];
+      cache->_reported[sizeClass] = cache->_stats[sizeClass];
+    }
+  }
+
+  static void push_batch(std::size_t sizeClass, FreeBlock* batch,
+                         std::size_t count, ThreadCache* cache) noexcept {
+    header_of(batch)->_batchSize = count;
+    DepotClass& depotClass{depot()._classes[sizeClass]};
+    std::lock_guard<std::mutex> lock{depotClass._mutex};
+    batch->_nextBatch = depotClass._batches;
+    depotClass._batches = batch;
+    fold_stats(depotClass, cache, sizeClass);
+  }
+
+  static bool refill(ThreadCache& cache, std::size_t sizeClass) noexcept {
+    DepotClass& depotClass{depot()._classes[sizeClass]};
+    std::lock_guard<std::mutex> lock{depotClass._mutex};
+    FreeBlock* batch{depotClass._batches};
+    if (batch) {
+      depotClass._batches = batch->_nextBatch;
+      Magazine& magazine{cache._magazines[sizeClass]};
+      magazine._head = batch;
+      magazine._count = header_of(batch)->_batchSize;
+      ++cache._stats[sizeClass].refills;
+    }
+    fold_stats(depotClass, &cache, sizeClass);
+    return batch;
+  }
+
+  // move the oldest-pushed half of a full magazine to the depot, keeping the
+  // recently freed (cache-warm) blocks on this thread
+  static void flush(ThreadCache& cache, std::size_t sizeClass) noexcept {
+    Magazine& magazine{cache._magazines[sizeClass]};
+    std::size_t keep{magazine._count - batch_size(sizeClass)};
+    FreeBlock* last{magazine._head};
+    for (std::size_t i{1}; i < keep; ++i) {
+      last = last->_next;
+    }
+    FreeBlock* batch{last->_next};
+    last->_next = nullptr;
+    magazine._count = keep;
+    ++cache._stats[sizeClass].flushes;
+    push_batch(sizeClass, batch, batch_size(sizeClass), &cache);
+  }
+
+  static void return_magazine(ThreadCache& cache,
+                              std::size_t sizeClass) noexcept {
+    Magazine& magazine{cache._magazines[sizeClass]};
+    if (!magazine._head) {
+      return;
+    }
+    ++cache._stats[sizeClass].flushes;
+    push_batch(sizeClass, magazine._head, magazine._count, &cache);
+    magazine._head = nullptr;
+    magazine._count = 0;
+  }
+};
+
+// Allocator<T> drop-in backed by the MagazineCache. Stateless, so default
+// constructed copies (as in Node::operator new) share the calling thread's
+// magazines.
+template <typename T> class CachingAllocator {
+
+public:
+  using value_type = T;
+
+  using pointer = value_type*;
+  using const_pointer = const pointer;
+
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using rvalue_reference = value_type&&;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  template <typename U> struct rebind {
+    using other = CachingAllocator<U>;
+  };
+
+  CachingAllocator(){};
+  ~CachingAllocator(){};
+  CachingAllocator(const CachingAllocator&){};
+  template <typename U> CachingAllocator(const CachingAllocator<U>&) {}
+
+  // address
+  pointer address(reference r) { return &r; };
+  pointer address(const_reference r) const { return &r; };
+
+  // memory allocation
+  pointer allocate(size_type count = 1, const void* = 0) {
+    static_assert(alignof(value_type) <= MagazineCache::HEADER_SIZE,
+                  "over-aligned types are not supported");
+    return static_cast<pointer>(MagazineCache::allocate(
+        std::max<size_type>(count, 1) * sizeof(value_type)));
+  };
+  void deallocate(pointer p, size_type = 0) { MagazineCache::deallocate(p); };
+
+  // ctor / detor
+  void construct(pointer p) { new (p) value_type{}; };
+  void construct(pointer p, const_reference t) { new (p) value_type{t}; };
+  void construct(pointer p, rvalue_reference t) {
+    new (p) value_type{std::move(t)};
+  };
+  void destruct(pointer p) { p->~value_type(); };
+
+  bool operator==(CachingAllocator const&) { return true; };
+  bool operator!=(CachingAllocator const& a) { return !(*this == a); };
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+
+  // number of elements that fit in the block serving count elements, lets
+  // growable containers use the whole size class
+  static constexpr size_type good_size(size_type count) noexcept {
+    size_type bytes{std::max<size_type>(count, 1) * sizeof(value_type)};
+    if (bytes > MagazineCache::MAX_CACHED_SIZE) {
+      return count;
+    }
+    return MagazineCache::class_size(MagazineCache::size_class(bytes)) /
+           sizeof(value_type);
+  }
+
+  // counters of the size class a single value_type maps to
+  static MagazineCache::Stats thread_stats() noexcept {
+    return MagazineCache::thread_stats(
+        MagazineCache::size_class(sizeof(value_type)));
+  }
+  static MagazineCache::Stats global_stats() {
+    return MagazineCache::global_stats(
+        MagazineCache::size_class(sizeof(value_type)));
+  }
+};
+
+template <> class CachingAllocator<void> {
+  using value_type = void;
+  using pointer = void*;
+  using const_pointer = const void*;
+
+public:
+  template <class U> struct rebind {
+    using other = CachingAllocator<U>;
+  };
+};
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <utility>
+
+// Fixed-size block pool. Blocks are carved out of large chunks with a bump
+// pointer and recycled through an intrusive free list, so both allocate and
+// deallocate are O(1) and never touch the system allocator once warmed up.
+// Chunks are only returned to the system when the pool is destroyed.
+// Not thread-safe, same as the containers that use it.
+template <std::size_t BlockSize, std::size_t BlockAlign,
+          std::size_t BlocksPerChunk>
+class FixedSizePool {
+  union Block {
+    Block* _next;
+    alignas(BlockAlign) std::byte _storage[BlockSize];
+  };
+
+  struct Chunk {
+    Chunk* _next{nullptr};
+    Block _blocks[BlocksPerChunk];
+  };
+
+  Block* _freeList{nullptr};
+  Chunk* _chunks{nullptr};
+  // next never-used block in the newest chunk
+  std::size_t _cursor{BlocksPerChunk};
+  std::size_t _chunkCount{};
+
+public:
+  FixedSizePool() = default;
+  ~FixedSizePool() { release(); }
+
+  FixedSizePool(const FixedSizePool&) = delete;
+  FixedSizePool& operator=(const FixedSizePool&) = delete;
+
+  // one pool per (size, alignment), shared by every type that maps onto it
+  static FixedSizePool& instance() {
+    static FixedSizePool pool{};
+    return pool;
+  }
+
+  void* allocate() {
+    if (_freeList) {
+      Block* block{_freeList};
+      _freeList = block->_next;
+      return block;
+    }
+    if (_cursor == BlocksPerChunk) {
+      Chunk* chunk{new Chunk};
+      chunk->_next = _chunks;
+      _chunks = chunk;
+      _cursor = 0;
+      ++_chunkCount;
+    }
+    return &_chunks->_blocks[_cursor++];
+  }
+
+  void deallocate(void* p) noexcept {
+    Block* block{static_cast<Block*>(p)};
+    block->_next = _freeList;
+    _freeList = block;
+  }
+
+  // give every chunk back to the system, all outstanding blocks are invalid
+  // afterwards
+  void release() noexcept {
+    while (_chunks) {
+      Chunk* next{_chunks->_next};
+      delete _chunks;
+      _chunks = next;
+    }
+    _freeList = nullptr;
+    _cursor = BlocksPerChunk;
+    _chunkCount = 0;
+  }
+
+  std::size_t chunk_count() const noexcept { return _chunkCount; }
+  static constexpr std::size_t chunk_capacity() noexcept {
+    return BlocksPerChunk;
+  }
+};
+
+// Node allocator for the node based containers (trees, tries, heaps).
+// Single object requests are served from a FixedSizePool shared by all types
+// of the same size and alignment; array requests fall back to ::operator new
+// and must be deallocated with the same count.
+// Because the pool is shared, a default constructed PoolAllocator (as done in
+// Node::operator new) always sees the same free list.
+template <typename T, std::size_t BlocksPerChunk = 1024> class PoolAllocator {
+
+public:
+  using value_type = T;
+
+  using pointer = value_type*;
+  using const_pointer = const pointer;
+
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using rvalue_reference = value_type&&;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using pool_type = FixedSizePool<sizeof(value_type), alignof(value_type),
+                                  BlocksPerChunk>;
+
+  template <typename U> struct rebind {
+    using other = PoolAllocator<U, BlocksPerChunk>;
+  };
+
+  PoolAllocator(){};
+  ~PoolAllocator(){};
+  PoolAllocator(const PoolAllocator&){};
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U, BlocksPerChunk>&) {}
+
+  // address
+  pointer address(reference r) { return &r; };
+  pointer address(const_reference r) const { return &r; };
+
+  // memory allocation
+  // count == 0 is treated as a single object, matching deallocate's default
+  pointer allocate(size_type count = 1, const void* = 0) {
+    if (count > 1) {
+      return reinterpret_cast<pointer>(
+          ::operator new(count * sizeof(value_type)));
+    }
+    return static_cast<pointer>(pool_type::instance().allocate());
+  };
+  void deallocate(pointer p, size_type count = 0) {
+    if (!p) {
+      return;
+    }
+    if (count > 1) {
+      ::operator delete(p);
+      return;
+    }
+    pool_type::instance().deallocate(p);
+  };
+
+  // ctor / detor
+  void construct(pointer p) { new (p) value_type{}; };
+  void construct(pointer p, const_reference t) { new (p) value_type{t}; };
+  void construct(pointer p, rvalue_reference t) {
+    new (p) value_type{std::move(t)};
+  };
+  void destruct(pointer p) { p->~value_type(); };
+
+  bool operator==(PoolAllocator const&) { return true; };
+  bool operator!=(PoolAllocator const& a) { return !(*this == a); };
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+
+  static pool_type& pool() { return pool_type::instance(); }
+};
+
+template <std::size_t BlocksPerChunk>
+class PoolAllocator<void, BlocksPerChunk> {
+  using value_type = void;
+  using pointer = void*;
+  using const_pointer = const void*;
+
+public:
+  template <class U> struct rebind {
+    using other = PoolAllocator<U, BlocksPerChunk>;
+  };
+};
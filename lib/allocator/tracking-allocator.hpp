@@ -0,0 +1,211 @@
+#pragma once
+
+#include <algorithm>
+#include <allocator.hpp>
+#include <atomic>
+#include <concept.hpp>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <utility>
+
+// memory events only reach the profiler when the target links
+// Tracy::TracyClient, everything else still gets the counters
+#if __has_include(<tracy/Tracy.hpp>)
+#include <tracy/Tracy.hpp>
+#else
+#define TracyAllocN(ptr, size, name)
+#define TracyFreeN(ptr, name)
+#endif
+
+// Allocation counters of one named pool. Every TrackingAllocator with the
+// same Tag reports into the same pool, whatever T it has been rebound to, so
+// a tree's nodes and a Deque's blocks and map are all accounted to their
+// container. Counters are atomic, pools may be shared between threads.
+class TrackedPool {
+public:
+  struct Stats {
+    std::size_t liveBytes{};
+    std::size_t peakBytes{};
+    std::size_t allocations{};
+    std::size_t deallocations{};
+
+    std::size_t live_allocations() const noexcept {
+      return allocations - deallocations;
+    }
+  };
+
+private:
+  const char* _name;
+  std::atomic<std::size_t> _liveBytes{};
+  std::atomic<std::size_t> _peakBytes{};
+  std::atomic<std::size_t> _allocations{};
+  std::atomic<std::size_t> _deallocations{};
+  TrackedPool* _next{nullptr};
+
+  inline static std::atomic<TrackedPool*> _pools{nullptr};
+
+  explicit TrackedPool(const char* name) : _name{name} {
+    _next = _pools.load(std::memory_order_relaxed);
+    while (!_pools.compare_exchange_weak(_next, this,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+    }
+  }
+
+public:
+  TrackedPool(const TrackedPool&) = delete;
+  TrackedPool& operator=(const TrackedPool&) = delete;
+
+  // one pool per Tag, never destroyed so containers with static storage can
+  // still report their frees while the program shuts down
+  template <typename Tag> static TrackedPool& of() {
+    static TrackedPool* pool{new TrackedPool{Tag::name}};
+    return *pool;
+  }
+
+  // visit every pool created so far, e.g. to find the biggest live one
+  template <typename Fn> static void for_each(Fn fn) {
+    for (TrackedPool* pool{_pools.load(std::memory_order_acquire)}; pool;
+         pool = pool->_next) {
+      fn(*pool);
+    }
+  }
+
+  const char* name() const noexcept { return _name; }
+
+  Stats stats() const noexcept {
+    return Stats{_liveBytes.load(std::memory_order_relaxed),
+                 _peakBytes.load(std::memory_order_relaxed),
+                 _allocations.load(std::memory_order_relaxed),
+                 _deallocations.load(std::memory_order_relaxed)};
+  }
+
+  // start a new peak measurement from the current live size
+  void reset_peak() noexcept {
+    _peakBytes.store(_liveBytes.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+  }
+
+  void on_allocate([[maybe_unused]] void* p, std::size_t bytes) noexcept {
+    TracyAllocN(p, bytes, _name);
+    _allocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t live{_liveBytes.fetch_add(bytes, std::memory_order_relaxed) +
+                     bytes};
+    std::size_t peak{_peakBytes.load(std::memory_order_relaxed)};
+    while (live > peak && !_peakBytes.compare_exchange_weak(
+                              peak, live, std::memory_order_relaxed)) {
+    }
+  }
+
+  void on_deallocate([[maybe_unused]] void* p, std::size_t bytes) noexcept {
+    TracyFreeN(p, _name);
+    _deallocations.fetch_add(1, std::memory_order_relaxed);
+    _liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+};
+
+struct DefaultTrackedPool {
+  static constexpr const char name[]{"default"};
+};
+
+// Instrumenting wrapper around any concepts::Allocator. Allocations and frees
+// are forwarded to Inner and reported to Tracy and to the TrackedPool of Tag,
+// which must provide a static `name` string:
+//
+//   struct VectorPool { static constexpr const char name[]{"Vector"}; };
+//   Vector<int, TrackingAllocator<int, VectorPool>> vector;
+//   TrackingAllocator<int, VectorPool>::stats().peakBytes;
+//
+// Byte counts come from the count passed to deallocate, which must match the
+// one given to allocate (0 counts as a single object, as in allocate).
+template <typename T, typename Tag = DefaultTrackedPool,
+          typename Inner = Allocator<T>>
+class TrackingAllocator {
+  Inner _inner{};
+
+public:
+  using value_type = T;
+
+  using pointer = value_type*;
+  using const_pointer = const pointer;
+
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using rvalue_reference = value_type&&;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // an arena stays an arena when tracked
+  inline static constexpr bool is_monotonic{
+      concepts::MonotonicAllocator<Inner>};
+
+  template <typename U> struct rebind {
+    using other =
+        TrackingAllocator<U, Tag, typename Inner::template rebind<U>::other>;
+  };
+
+  TrackingAllocator(){};
+  ~TrackingAllocator(){};
+  TrackingAllocator(const TrackingAllocator&) = default;
+  template <typename U, typename I>
+  TrackingAllocator(const TrackingAllocator<U, Tag, I>&) {}
+
+  static TrackedPool& pool() { return TrackedPool::of<Tag>(); }
+  static TrackedPool::Stats stats() { return pool().stats(); }
+
+  // address
+  pointer address(reference r) { return &r; };
+  pointer address(const_reference r) const { return &r; };
+
+  // memory allocation
+  pointer allocate(size_type count = 1, const void* hint = 0) {
+    pointer p{_inner.allocate(count, hint)};
+    pool().on_allocate(p, bytes(count));
+    return p;
+  };
+  void deallocate(pointer p, size_type count = 0) {
+    if (!p) {
+      return;
+    }
+    pool().on_deallocate(p, bytes(count));
+    _inner.deallocate(p, count);
+  };
+
+  // ctor / detor
+  void construct(pointer p) { new (p) value_type{}; };
+  void construct(pointer p, const_reference t) { new (p) value_type{t}; };
+  void construct(pointer p, rvalue_reference t) {
+    new (p) value_type{std::move(t)};
+  };
+  void destruct(pointer p) { p->~value_type(); };
+
+  bool operator==(TrackingAllocator const&) { return true; };
+  bool operator!=(TrackingAllocator const& a) { return !(*this == a); };
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+
+private:
+  static size_type bytes(size_type count) noexcept {
+    return std::max<size_type>(count, 1) * sizeof(value_type);
+  }
+};
+
+template <typename Tag, typename Inner>
+class TrackingAllocator<void, Tag, Inner> {
+  using value_type = void;
+  using pointer = void*;
+  using const_pointer = const void*;
+
+public:
+  template <class U> struct rebind {
+    using other =
+        TrackingAllocator<U, Tag, typename Inner::template rebind<U>::other>;
+  };
+
+  static TrackedPool& pool() { return TrackedPool::of<Tag>(); }
+  static TrackedPool::Stats stats() { return pool().stats(); }
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <concepts>
+#include <type_traits>
 
 namespace concepts {
 
@@ -50,6 +51,24 @@ concept Allocator =
       allocator.destruct(ptr);
     };
 
+// allocators whose deallocate is a no-op and whose memory is reclaimed in
+// bulk, so containers may skip destroying trivially destructible nodes
+template <typename T>
+concept MonotonicAllocator = Allocator<T> && T::is_monotonic;
+
+// containers that hand out their elements as contiguous runs, front to
+// back, e.g. Deque::for_each_segment
+template <typename T>
+concept Segmented =
+    requires(const T& container) { container.for_each_segment([](auto) {}); };
+
+// containers whose elements are one array
+template <typename T>
+concept Contiguous = requires(T& container) {
+  requires std::is_pointer_v<decltype(container.data())>;
+  container.size();
+};
+
 template <typename T, typename Q>
 concept IsSameBase = std::same_as<std::remove_cv_t<std::remove_reference_t<T>>,
                                   std::remove_cv_t<std::remove_reference_t<Q>>>;
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector.hpp>
+
+// Epoch based reclamation, for lock-free structures that unlink nodes other
+// threads may still be reading.
+// A thread pins itself with a Guard before it touches shared nodes. Unlinked
+// nodes are handed to retire() instead of being freed; each is tagged with
+// the global epoch. The global epoch only moves forward once every pinned
+// thread has seen the current one, so when it is two past a node's tag no
+// thread can still be holding the node and it is freed.
+// Because a node is never reused while anyone can see it, this also rules
+// out ABA on compare-and-swap of node pointers.
+//
+//   epoch::Guard guard{};
+//   Node* head{_head.load()};
+//   while (head && !_head.compare_exchange_weak(head, head->_next)) {}
+//   if (head) {
+//     epoch::retire(head);
+//   }
+//
+// Every structure shares one epoch, so a thread pinned for one holds back
+// the garbage of all of them; keep guards short.
+namespace epoch {
+
+using Deleter = void (*)(void*);
+
+namespace detail {
+
+inline constexpr std::uint64_t IDLE{std::numeric_limits<std::uint64_t>::max()};
+inline constexpr std::size_t CACHE_LINE{64};
+// retirements between two attempts to advance the epoch
+inline constexpr std::size_t ADVANCE_EVERY{64};
+
+// the epoch a thread is pinned at, one per thread, reused after it exits
+struct alignas(CACHE_LINE) Record {
+  std::atomic<std::uint64_t> _epoch{IDLE};
+  std::atomic<bool> _taken{true};
+  Record* _next{nullptr};
+};
+
+struct Retired {
+  void* _pointer;
+  Deleter _deleter;
+  std::uint64_t _epoch;
+};
+
+// starts at 2 so epoch - 2 never wraps around
+inline std::atomic<std::uint64_t> globalEpoch{2};
+// grow only, records are never freed
+inline std::atomic<Record*> records{nullptr};
+
+// garbage left behind by threads that exited, freed by reclaim() and by
+// whichever thread next advances the epoch from retire()
+inline std::mutex orphansMutex{};
+inline Vector<Retired> orphans{};
+
+inline bool isSafe(const Retired& retired, std::uint64_t global) {
+  return retired._epoch + 2 <= global;
+}
+
+// frees what is safe at global and keeps the rest
+inline void collect(Vector<Retired>& retired, std::uint64_t global) {
+  Vector<Retired> kept{};
+  for (const Retired& item : retired) {
+    if (isSafe(item, global)) {
+      item._deleter(item._pointer);
+    } else {
+      kept.push_back(item);
+    }
+  }
+  retired.swap(kept);
+}
+
+inline Record* acquireRecord() {
+  for (Record* record{records.load(std::memory_order_acquire)}; record;
+       record = record->_next) {
+    bool taken{false};
+    if (!record->_taken.load(std::memory_order_relaxed) &&
+        record->_taken.compare_exchange_strong(taken, true,
+                                               std::memory_order_acquire)) {
+      return record;
+    }
+  }
+  Record* record{new Record{}};
+  record->_next = records.load(std::memory_order_relaxed);
+  while (!records.compare_exchange_weak(record->_next, record,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+  }
+  return record;
+}
+
+// moves the epoch on if every pinned thread is in the current one, returns
+// the epoch after the attempt
+inline std::uint64_t tryAdvance() {
+  std::uint64_t global{globalEpoch.load()};
+  for (Record* record{records.load(std::memory_order_acquire)}; record;
+       record = record->_next) {
+    std::uint64_t pinned{record->_epoch.load()};
+    if (pinned != IDLE && pinned != global) {
+      return global;
+    }
+  }
+  globalEpoch.compare_exchange_strong(global, global + 1);
+  return globalEpoch.load();
+}
+
+// retired pointers tagged with the same epoch
+struct Bucket {
+  std::uint64_t _epoch{};
+  Vector<Retired> _items{};
+
+  void release() {
+    for (const Retired& item : _items) {
+      item._deleter(item._pointer);
+    }
+    _items.clear();
+  }
+};
+
+class ThreadState {
+  Record* _record{acquireRecord()};
+  unsigned _depth{};
+  std::size_t _sinceAdvance{};
+  // one per epoch modulo 3, at most three epochs are ever pending
+  Bucket _buckets[3]{};
+
+  void releaseSafe(std::uint64_t global) {
+    for (Bucket& bucket : _buckets) {
+      if (bucket._epoch + 2 <= global) {
+        bucket.release();
+      }
+    }
+  }
+
+public:
+  ThreadState() = default;
+  ThreadState(const ThreadState&) = delete;
+  ThreadState& operator=(const ThreadState&) = delete;
+
+  ~ThreadState() {
+    {
+      std::lock_guard lock{orphansMutex};
+      for (Bucket& bucket : _buckets) {
+        for (const Retired& item : bucket._items) {
+          orphans.push_back(item);
+        }
+      }
+    }
+    _record->_taken.store(false, std::memory_order_release);
+  }
+
+  void pin() {
+    if (_depth++ == 0) {
+      // seq_cst orders the store before every load of a shared node
+      _record->_epoch.store(globalEpoch.load());
+    }
+  }
+
+  void unpin() {
+    if (--_depth == 0) {
+      _record->_epoch.store(IDLE, std::memory_order_release);
+    }
+  }
+
+  void retire(void* pointer, Deleter deleter) {
+    // read after the node was unlinked, so nobody pinned later can find it
+    std::uint64_t global{globalEpoch.load()};
+    Bucket& bucket{_buckets[global % 3]};
+    if (bucket._epoch != global) {
+      // the bucket's epoch is at least three behind, all of it is safe
+      bucket.release();
+      bucket._epoch = global;
+    }
+    bucket._items.push_back({pointer, deleter, global});
+    if (++_sinceAdvance >= ADVANCE_EVERY) {
+      _sinceAdvance = 0;
+      std::uint64_t advanced{tryAdvance()};
+      releaseSafe(advanced);
+      // leave the orphans to the next one if another thread is at them
+      std::unique_lock lock{orphansMutex, std::try_to_lock};
+      if (lock.owns_lock() && !orphans.empty()) {
+        collect(orphans, advanced);
+      }
+    }
+  }
+
+  void reclaim() {
+    // two steps make everything retired so far safe, unless someone pins
+    tryAdvance();
+    std::uint64_t global{tryAdvance()};
+    releaseSafe(global);
+    std::lock_guard lock{orphansMutex};
+    collect(orphans, global);
+  }
+
+  std::size_t pending() const {
+    std::size_t count{};
+    for (const Bucket& bucket : _buckets) {
+      count += bucket._items.size();
+    }
+    return count;
+  }
+};
+
+inline ThreadState& local() {
+  thread_local ThreadState state{};
+  return state;
+}
+
+} // namespace detail
+
+// pins the calling thread for its lifetime, nodes read meanwhile stay valid.
+// Guards nest.
+class Guard {
+public:
+  Guard() { detail::local().pin(); }
+  ~Guard() { detail::local().unpin(); }
+
+  Guard(const Guard&) = delete;
+  Guard& operator=(const Guard&) = delete;
+};
+
+// frees pointer with deleter once no thread can be reading it. pointer must
+// already be unreachable for threads that pin from now on.
+inline void retire(void* pointer, Deleter deleter) {
+  detail::local().retire(pointer, deleter);
+}
+
+template <typename T> void retire(T* pointer) {
+  retire(pointer, [](void* p) { delete static_cast<T*>(p); });
+}
+
+// moves the epoch on as far as the pinned threads allow and frees whatever
+// became safe, e.g. when a thread goes idle. With no thread pinned that is
+// everything retired so far. Call it unpinned.
+inline void reclaim() { detail::local().reclaim(); }
+
+// nodes the calling thread retired that are not freed yet
+inline std::size_t pending() { return detail::local().pending(); }
+
+} // namespace epoch
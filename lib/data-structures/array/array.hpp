@@ -3,6 +3,7 @@
 #include <concept.hpp>
 #include <cstddef>
 #include <initializer_list>
+#include <simd.hpp>
 #include <string>
 #include <utility>
 
@@ -94,6 +95,23 @@ public:
   T* data() { return _elements; };
   const T* data() const { return _elements; };
 
+  /* Algorithms */
+  // linear scans with algorithms::simd, vectorised for arithmetic T.
+  // Searches return an index, N when there is no match.
+  std::size_t find(const T& value) const {
+    return algorithms::simd::find(_elements, N, value);
+  };
+  std::size_t count(const T& value) const {
+    return algorithms::simd::count(_elements, N, value);
+  };
+  std::size_t min_element() const {
+    return algorithms::simd::min_element(_elements, N);
+  };
+  std::size_t max_element() const {
+    return algorithms::simd::max_element(_elements, N);
+  };
+  void fill(const T& value) { algorithms::simd::fill(_elements, N, value); };
+
   void swap(self& other) noexcept {
     using std::swap;
     swap(_elements, other._elements);
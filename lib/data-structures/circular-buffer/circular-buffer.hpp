@@ -2,9 +2,11 @@
 
 #include <allocator.hpp>
 #include <array.hpp>
+#include <array>
 #include <concept.hpp>
 #include <cstddef>
 #include <initializer_list>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector.hpp>
@@ -57,7 +59,7 @@ public:
     while (!empty()) {
       pop_front();
     }
-    _allocator.deallocate(_elements);
+    _allocator.deallocate(_elements, N);
   };
   CircularBuffer(const self& other)
       : _allocator{other._allocator}, _head{other._head}, _tail{other._head},
@@ -271,6 +273,36 @@ public:
   iterator cbegin() const { return {_head, this}; }
   iterator cend() const { return {_tail, this, _size}; }
 
+  /* Segments */
+  // the elements as the runs they occupy in storage, front to back. The
+  // second run is empty unless the elements wrap around the end.
+  std::array<std::span<T>, 2> segments() {
+    std::size_t run{first_run()};
+    return {std::span<T>{_elements + _head, run},
+            std::span<T>{_elements, _size - run}};
+  }
+  std::array<std::span<const T>, 2> segments() const {
+    std::size_t run{first_run()};
+    return {std::span<const T>{_elements + _head, run},
+            std::span<const T>{_elements, _size - run}};
+  }
+
+  // calls fn with every non-empty run of segments()
+  template <typename Fn> void for_each_segment(Fn&& fn) {
+    for (std::span<T> segment : segments()) {
+      if (!segment.empty()) {
+        fn(segment);
+      }
+    }
+  }
+  template <typename Fn> void for_each_segment(Fn&& fn) const {
+    for (std::span<const T> segment : segments()) {
+      if (!segment.empty()) {
+        fn(segment);
+      }
+    }
+  }
+
 private:
   Allocator _allocator{};
   std::size_t _head{};
@@ -292,6 +324,11 @@ private:
     return i;
   }
 
+  // elements from _head up to the end of storage, the rest wrap to index 0
+  std::size_t first_run() const noexcept {
+    return _size < N - _head ? _size : N - _head;
+  }
+
 public:
   class OutOfRangeException : public std::exception {
     friend class CircularBuffer;
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <contiguous-iterator.hpp>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+// Circular buffer whose storage is mapped twice, back to back: the byte
+// after the last slot is the first slot again. Whatever the head is, the
+// elements (and the free space after them) are one contiguous range, so a
+// parser or a read()/write() syscall can work on the buffer in place instead
+// of going around the wrap element by element.
+//
+//   MagicCircularBuffer<char> in{64 * 1024};
+//   std::span<char> free{in.write_span()};
+//   ssize_t got{::read(fd, free.data(), free.size())};
+//   if (got < 0) { /* errno */ }
+//   in.commit(static_cast<std::size_t>(got));
+//   std::size_t used{parse(in.read_span())};
+//   in.consume(used);
+//
+// The capacity is rounded up to whole pages, the unit mmap works with. The
+// pages come from an anonymous memfd, Linux only. Only for trivially
+// copyable T, elements are stored as raw bytes.
+template <typename T> class MagicCircularBuffer {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MagicCircularBuffer stores elements as raw bytes");
+  static_assert(std::has_single_bit(sizeof(T)) && sizeof(T) <= 4096,
+                "elements must tile a page exactly");
+
+public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using Iterator = ContiguousIterator<T>;
+  using ConstIterator = ContiguousIterator<const T>;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+  using self = MagicCircularBuffer<T>;
+
+  class OutOfRangeException : public std::exception {
+    using std::exception::what;
+
+  private:
+    std::string message;
+
+  public:
+    OutOfRangeException(std::string msg) : message{msg} {}
+    std::string what() { return message; }
+  };
+
+private:
+  // 2 * _capacity elements, the second half aliases the first
+  T* _elements{nullptr};
+  std::size_t _capacity{};
+  // always < _capacity, so _head + _size stays within the mirror
+  std::size_t _head{};
+  std::size_t _size{};
+
+  [[noreturn]] static void fail(const char* what) {
+    throw std::system_error{errno, std::generic_category(),
+                            std::string{"MagicCircularBuffer "} + what};
+  }
+
+  static std::size_t page_size() {
+    static const std::size_t pageSize{
+        static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+    return pageSize;
+  }
+
+  // elements in the whole pages (at least one) able to hold capacity
+  static std::size_t capacity_for(std::size_t capacity) {
+    std::size_t bytes{std::max<std::size_t>(capacity * sizeof(T), 1)};
+    return (bytes + page_size() - 1) / page_size() * page_size() / sizeof(T);
+  }
+
+  std::size_t bytes() const { return _capacity * sizeof(T); }
+
+  // reserves 2 * bytes of address space, then maps the same memfd pages
+  // over both halves
+  void map(std::size_t bytes) {
+    int fd{::memfd_create("magic-circular-buffer", MFD_CLOEXEC)};
+    if (fd < 0) {
+      fail("memfd_create");
+    }
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+      ::close(fd);
+      fail("ftruncate");
+    }
+    void* reserved{::mmap(nullptr, 2 * bytes, PROT_NONE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+    if (reserved == MAP_FAILED) {
+      ::close(fd);
+      fail("mmap");
+    }
+    auto* base{static_cast<std::byte*>(reserved)};
+    for (std::byte* half : {base, base + bytes}) {
+      if (::mmap(half, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+                 fd, 0) == MAP_FAILED) {
+        ::munmap(reserved, 2 * bytes);
+        ::close(fd);
+        fail("mmap");
+      }
+    }
+    // the mappings keep the memory alive
+    ::close(fd);
+    _elements = reinterpret_cast<T*>(base);
+  }
+
+  void validateIndex(std::size_t index) const {
+    if (index >= _size) {
+      throw OutOfRangeException{"Index out of range"};
+    }
+  }
+
+public:
+  /* Constructors */
+  // room for at least capacity elements
+  explicit MagicCircularBuffer(std::size_t capacity)
+      : _capacity{capacity_for(capacity)} {
+    map(bytes());
+  }
+
+  ~MagicCircularBuffer() {
+    if (_elements) {
+      ::munmap(_elements, 2 * bytes());
+    }
+  }
+
+  MagicCircularBuffer(const self&) = delete;
+  self& operator=(const self&) = delete;
+
+  MagicCircularBuffer(self&& move) noexcept
+      : _elements{std::exchange(move._elements, nullptr)},
+        _capacity{std::exchange(move._capacity, 0)},
+        _head{std::exchange(move._head, 0)},
+        _size{std::exchange(move._size, 0)} {}
+
+  self& operator=(self&& move) noexcept {
+    self tempMove{std::move(move)};
+    swap(tempMove);
+    return *this;
+  }
+
+  /* Spans */
+  // every element, front first
+  std::span<T> read_span() { return {_elements + _head, _size}; }
+  std::span<const T> read_span() const { return {_elements + _head, _size}; }
+
+  // the free slots after the back, fill a prefix and commit it
+  std::span<T> write_span() {
+    return {_elements + _head + _size, _capacity - _size};
+  }
+
+  // appends the first count elements of write_span()
+  void commit(std::size_t count) {
+    if (count > _capacity - _size) {
+      throw OutOfRangeException{"commit past the free space"};
+    }
+    _size += count;
+  }
+
+  // drops the first count elements of read_span()
+  void consume(std::size_t count) {
+    if (count > _size) {
+      throw OutOfRangeException{"consume past the elements"};
+    }
+    _head += count;
+    if (_head >= _capacity) {
+      _head -= _capacity;
+    }
+    _size -= count;
+  }
+
+  /* Iterators */
+  Iterator begin() { return _elements + _head; }
+  Iterator end() { return _elements + _head + _size; }
+  ConstIterator begin() const { return _elements + _head; }
+  ConstIterator end() const { return _elements + _head + _size; }
+  ConstIterator cbegin() const { return _elements + _head; }
+  ConstIterator cend() const { return _elements + _head + _size; }
+
+  /* Capacity */
+  bool empty() const noexcept { return _size == 0; }
+  bool is_full() const noexcept { return _size == _capacity; }
+  std::size_t size() const noexcept { return _size; }
+  std::size_t capacity() const noexcept { return _capacity; }
+
+  /* Modifiers */
+  void push_back(const T& element) {
+    if (is_full()) {
+      throw std::runtime_error("buffer is full");
+    }
+    _elements[_head + _size] = element;
+    ++_size;
+  }
+
+  // copies in as much of elements as fits, returns how many
+  std::size_t push_back(std::span<const T> elements) {
+    std::size_t count{std::min(elements.size(), _capacity - _size)};
+    std::copy_n(elements.data(), count, _elements + _head + _size);
+    _size += count;
+    return count;
+  }
+
+  T pop_front() {
+    T value{_elements[_head]};
+    consume(1);
+    return value;
+  }
+
+  void clear() {
+    _head = 0;
+    _size = 0;
+  }
+
+  /* Element access */
+  T& operator[](std::size_t index) { return _elements[_head + index]; }
+  const T& operator[](std::size_t index) const {
+    return _elements[_head + index];
+  }
+
+  T& at(std::size_t index) {
+    validateIndex(index);
+    return (*this)[index];
+  }
+  const T& at(std::size_t index) const {
+    validateIndex(index);
+    return (*this)[index];
+  }
+
+  T& front() { return (*this)[0]; }
+  const T& front() const { return (*this)[0]; }
+  T& back() { return (*this)[_size - 1]; }
+  const T& back() const { return (*this)[_size - 1]; }
+
+  void swap(self& other) noexcept {
+    using std::swap;
+    swap(_elements, other._elements);
+    swap(_capacity, other._capacity);
+    swap(_head, other._head);
+    swap(_size, other._size);
+  }
+  friend void swap(self& a, self& b) noexcept { a.swap(b); }
+};
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <allocator.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+
+// Bounded FIFO for any number of producers and consumers, Dmitry Vyukov's
+// bounded MPMC queue. Like CircularBuffer it allocates N slots up front
+// through Allocator and constructs the elements in place.
+// Every slot carries a sequence number that says whose turn it is: a slot
+// at position pos is free for the producer of pos when its sequence is pos,
+// and holds the element for the consumer of pos when it is pos + 1. The
+// consumer hands it back to the producer of pos + N by setting it to
+// pos + N. Producers and consumers only contend on their own position
+// counter (one CAS per operation), and each slot is touched by one thread
+// at a time.
+// A power of two N turns the slot lookup into a mask.
+template <typename T, std::size_t N, typename Allocator = Allocator<T>>
+class MpmcCircularBuffer {
+  static_assert(N > 0, "MpmcCircularBuffer needs room for an element");
+
+  inline static constexpr std::size_t CACHE_LINE{64};
+  // failed attempts a blocking call spins for before it starts yielding
+  inline static constexpr int SPINS{64};
+
+  struct Slot {
+    std::atomic<std::size_t> _sequence{};
+    alignas(T) std::byte _storage[sizeof(T)];
+
+    T* element() { return std::launder(reinterpret_cast<T*>(_storage)); }
+  };
+
+  using SlotAllocator = typename Allocator::template rebind<Slot>::other;
+
+public:
+  using value_type = T;
+  using reference = T&;
+  using rvalue_reference = T&&;
+  using const_reference = const T&;
+  using self = MpmcCircularBuffer<T, N, Allocator>;
+
+private:
+  Allocator _allocator{};
+  SlotAllocator _slotAllocator{};
+  Slot* _slots{nullptr};
+  // producers and consumers each hammer their own counter, keep them apart
+  alignas(CACHE_LINE) std::atomic<std::size_t> _pushPos{0};
+  alignas(CACHE_LINE) std::atomic<std::size_t> _popPos{0};
+
+  // claims the slot for the next push, nullptr if the buffer is full
+  Slot* claimPush(std::size_t& pos) {
+    pos = _pushPos.load(std::memory_order_relaxed);
+    while (true) {
+      Slot* slot{_slots + pos % N};
+      std::size_t sequence{slot->_sequence.load(std::memory_order_acquire)};
+      auto diff{static_cast<std::ptrdiff_t>(sequence - pos)};
+      if (diff == 0) {
+        if (_pushPos.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed)) {
+          return slot;
+        }
+      } else if (diff < 0) {
+        // the consumer of pos - N has not taken its element yet
+        return nullptr;
+      } else {
+        pos = _pushPos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // claims the slot for the next pop, nullptr if the buffer is empty
+  Slot* claimPop(std::size_t& pos) {
+    pos = _popPos.load(std::memory_order_relaxed);
+    while (true) {
+      Slot* slot{_slots + pos % N};
+      std::size_t sequence{slot->_sequence.load(std::memory_order_acquire)};
+      auto diff{static_cast<std::ptrdiff_t>(sequence - (pos + 1))};
+      if (diff == 0) {
+        if (_popPos.compare_exchange_weak(pos, pos + 1,
+                                          std::memory_order_relaxed)) {
+          return slot;
+        }
+      } else if (diff < 0) {
+        return nullptr;
+      } else {
+        pos = _popPos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  template <typename U> bool tryPush(U&& element) {
+    std::size_t pos{};
+    Slot* slot{claimPush(pos)};
+    if (!slot) {
+      return false;
+    }
+    _allocator.construct(slot->element(), std::forward<U>(element));
+    slot->_sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // retries attempt until it succeeds or until is reached
+  template <typename Attempt, typename Until>
+  static auto retry(Attempt attempt, Until until) {
+    int spins{};
+    auto result{attempt()};
+    while (!result && !until()) {
+      if (++spins > SPINS) {
+        std::this_thread::yield();
+      }
+      result = attempt();
+    }
+    return result;
+  }
+
+  template <typename Rep, typename Period>
+  static auto deadline(std::chrono::duration<Rep, Period> timeout) {
+    return [end{std::chrono::steady_clock::now() + timeout}]() {
+      return std::chrono::steady_clock::now() >= end;
+    };
+  }
+
+  static bool forever() { return false; }
+
+public:
+  MpmcCircularBuffer() : _slots{_slotAllocator.allocate(N)} {
+    for (std::size_t i{}; i < N; ++i) {
+      _slotAllocator.construct(_slots + i);
+      _slots[i]._sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // only one thread may be left using the buffer
+  ~MpmcCircularBuffer() {
+    while (try_pop_front()) {
+    }
+    for (std::size_t i{}; i < N; ++i) {
+      _slotAllocator.destruct(_slots + i);
+    }
+    _slotAllocator.deallocate(_slots, N);
+  }
+
+  // other threads hold on to the slots, the buffer stays put
+  MpmcCircularBuffer(const self&) = delete;
+  self& operator=(const self&) = delete;
+
+  /* Producers */
+  // the element is only moved from when it was pushed
+  bool try_push_back(const_reference element) { return tryPush(element); }
+  bool try_push_back(rvalue_reference element) {
+    return tryPush(std::move(element));
+  }
+
+  void push_back(const_reference element) {
+    retry([&]() { return tryPush(element); }, forever);
+  }
+  void push_back(rvalue_reference element) {
+    retry([&]() { return tryPush(std::move(element)); }, forever);
+  }
+
+  // waits at most timeout for a free slot
+  template <typename Rep, typename Period>
+  bool try_push_back_for(const_reference element,
+                         std::chrono::duration<Rep, Period> timeout) {
+    return retry([&]() { return tryPush(element); }, deadline(timeout));
+  }
+  template <typename Rep, typename Period>
+  bool try_push_back_for(rvalue_reference element,
+                         std::chrono::duration<Rep, Period> timeout) {
+    return retry([&]() { return tryPush(std::move(element)); },
+                 deadline(timeout));
+  }
+
+  /* Consumers */
+  std::optional<T> try_pop_front() {
+    std::size_t pos{};
+    Slot* slot{claimPop(pos)};
+    if (!slot) {
+      return std::nullopt;
+    }
+    std::optional<T> value{std::move(*slot->element())};
+    _allocator.destruct(slot->element());
+    slot->_sequence.store(pos + N, std::memory_order_release);
+    return value;
+  }
+
+  T pop_front() {
+    return std::move(*retry([&]() { return try_pop_front(); }, forever));
+  }
+
+  // waits at most timeout for an element
+  template <typename Rep, typename Period>
+  std::optional<T> try_pop_front_for(
+      std::chrono::duration<Rep, Period> timeout) {
+    return retry([&]() { return try_pop_front(); }, deadline(timeout));
+  }
+
+  /* Capacity */
+  // only a snapshot while other threads are working on it
+  std::size_t size() const noexcept {
+    std::size_t popPos{_popPos.load(std::memory_order_acquire)};
+    std::size_t pushPos{_pushPos.load(std::memory_order_acquire)};
+    return pushPos > popPos ? pushPos - popPos : 0;
+  }
+  bool empty() const noexcept { return size() == 0; }
+  bool is_full() const noexcept { return size() >= N; }
+  constexpr std::size_t capacity() const noexcept { return N; }
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <thread>
+#include <utility>
+
+// Fixed capacity FIFO between exactly one producer thread (push_back) and one
+// consumer thread (pop_front), without locks.
+// _head and _tail only ever grow; a slot is found by masking them with the
+// storage size, which is N rounded up to a power of two. Each side owns one
+// index and publishes it with a release store, the other side reads it with
+// an acquire load, so the element written before the store is visible after
+// the load.
+// The two sides' indices sit on separate cache lines. Each side also keeps a
+// private copy of the other's index and only reloads it when the copy says
+// the buffer is full (or empty), so most calls don't touch the other core's
+// line at all.
+template <typename T, std::size_t N> class SpscCircularBuffer {
+  static_assert(N > 0, "SpscCircularBuffer needs room for an element");
+
+  inline static constexpr std::size_t CACHE_LINE{64};
+  inline static constexpr std::size_t STORAGE{std::bit_ceil(N)};
+  inline static constexpr std::size_t MASK{STORAGE - 1};
+
+public:
+  using value_type = T;
+  using reference = T&;
+  using rvalue_reference = T&&;
+  using const_reference = const T&;
+  using self = SpscCircularBuffer<T, N>;
+
+private:
+  /* Consumer side */
+  alignas(CACHE_LINE) std::atomic<std::size_t> _head{0};
+  std::size_t _cachedTail{0};
+
+  /* Producer side */
+  alignas(CACHE_LINE) std::atomic<std::size_t> _tail{0};
+  std::size_t _cachedHead{0};
+
+  alignas(CACHE_LINE) std::array<T, STORAGE> _elements{};
+
+  // free slots as seen by the producer, refreshes _cachedHead if short
+  std::size_t room(std::size_t tail, std::size_t wanted) {
+    if (N - (tail - _cachedHead) < wanted) {
+      _cachedHead = _head.load(std::memory_order_acquire);
+    }
+    return N - (tail - _cachedHead);
+  }
+
+  // ready elements as seen by the consumer, refreshes _cachedTail if short
+  std::size_t ready(std::size_t head, std::size_t wanted) {
+    if (_cachedTail - head < wanted) {
+      _cachedTail = _tail.load(std::memory_order_acquire);
+    }
+    return _cachedTail - head;
+  }
+
+public:
+  SpscCircularBuffer() = default;
+
+  // the indices are shared with other threads, the buffer stays put
+  SpscCircularBuffer(const self&) = delete;
+  self& operator=(const self&) = delete;
+
+  /* Producer */
+  bool try_push_back(const_reference element) {
+    std::size_t tail{_tail.load(std::memory_order_relaxed)};
+    if (room(tail, 1) == 0) {
+      return false;
+    }
+    _elements[tail & MASK] = element;
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_push_back(rvalue_reference element) {
+    std::size_t tail{_tail.load(std::memory_order_relaxed)};
+    if (room(tail, 1) == 0) {
+      return false;
+    }
+    _elements[tail & MASK] = std::move(element);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // waits for a free slot
+  void push_back(const_reference element) {
+    while (!try_push_back(element)) {
+      std::this_thread::yield();
+    }
+  }
+
+  void push_back(rvalue_reference element) {
+    while (!try_push_back(std::move(element))) {
+      std::this_thread::yield();
+    }
+  }
+
+  // copies up to count elements from first, returns how many fit. The batch
+  // is published with a single store.
+  template <std::input_iterator InputIterator>
+  std::size_t try_push_n(InputIterator first, std::size_t count) {
+    std::size_t tail{_tail.load(std::memory_order_relaxed)};
+    count = std::min(count, room(tail, count));
+    for (std::size_t i{}; i < count; ++i, ++first) {
+      _elements[(tail + i) & MASK] = *first;
+    }
+    _tail.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  /* Consumer */
+  std::optional<T> try_pop_front() {
+    std::size_t head{_head.load(std::memory_order_relaxed)};
+    if (ready(head, 1) == 0) {
+      return std::nullopt;
+    }
+    std::optional<T> value{std::move(_elements[head & MASK])};
+    _head.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+  // waits for an element
+  T pop_front() {
+    std::optional<T> value{try_pop_front()};
+    while (!value) {
+      std::this_thread::yield();
+      value = try_pop_front();
+    }
+    return std::move(*value);
+  }
+
+  // moves up to count elements to out, returns how many. The elements are
+  // read as (at most) two contiguous runs and released with a single store.
+  template <typename OutputIterator>
+  std::size_t try_pop_n(OutputIterator out, std::size_t count) {
+    std::size_t head{_head.load(std::memory_order_relaxed)};
+    count = std::min(count, ready(head, count));
+    std::size_t first{head & MASK};
+    std::size_t firstRun{std::min(count, STORAGE - first)};
+    auto start{_elements.begin() + static_cast<std::ptrdiff_t>(first)};
+    out = std::move(start, start + static_cast<std::ptrdiff_t>(firstRun), out);
+    std::move(_elements.begin(),
+              _elements.begin() + static_cast<std::ptrdiff_t>(count - firstRun),
+              out);
+    _head.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  /* Capacity */
+  // exact on either side when the other is idle, a snapshot otherwise
+  std::size_t size() const noexcept {
+    std::size_t head{_head.load(std::memory_order_acquire)};
+    std::size_t tail{_tail.load(std::memory_order_acquire)};
+    return tail > head ? tail - head : 0;
+  }
+  bool empty() const noexcept { return size() == 0; }
+  bool is_full() const noexcept { return size() == N; }
+  constexpr std::size_t capacity() const noexcept { return N; }
+};
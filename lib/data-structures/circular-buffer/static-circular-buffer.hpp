@@ -1,9 +1,12 @@
 #pragma once
 
 #include <array.hpp>
+#include <array>
 #include <cstddef>
 #include <initializer_list>
 #include <string>
+#include <simd.hpp>
+#include <span>
 #include <utility>
 #include <vector.hpp>
 
@@ -116,10 +119,10 @@ public:
   }
 
   reference front() { return (*this)[0]; };
-  reference front() const { return (*this)[0]; };
+  const_reference front() const { return (*this)[0]; };
 
   reference back() { return (*this)[size() - 1]; };
-  reference back() const { return (*this)[size() - 1]; };
+  const_reference back() const { return (*this)[size() - 1]; };
 
   void swap(self& other) noexcept {
     using std::swap;
@@ -282,6 +285,67 @@ public:
     return value;
   }
 
+  /* Segments */
+  // the elements as the runs they occupy in storage, front to back. The
+  // second run is empty unless the elements wrap around the end.
+  std::array<std::span<T>, 2> segments() {
+    std::size_t run{firstRun()};
+    return {std::span<T>{_elements.data() + _head, run},
+            std::span<T>{_elements.data(), _size - run}};
+  }
+  std::array<std::span<const T>, 2> segments() const {
+    std::size_t run{firstRun()};
+    return {std::span<const T>{data(_head), run},
+            std::span<const T>{data(0), _size - run}};
+  }
+
+  // calls fn with every non-empty run of segments()
+  template <typename Fn> void for_each_segment(Fn&& fn) {
+    for (std::span<T> segment : segments()) {
+      if (!segment.empty()) {
+        fn(segment);
+      }
+    }
+  }
+  template <typename Fn> void for_each_segment(Fn&& fn) const {
+    for (std::span<const T> segment : segments()) {
+      if (!segment.empty()) {
+        fn(segment);
+      }
+    }
+  }
+
+  /* Algorithms */
+  // Linear scans over the elements, front to back, run on the two contiguous
+  // runs of the ring with algorithms::simd, vectorised for arithmetic T.
+  // Searches return an index, size() when there is no match.
+  std::size_t find(const_reference value) const {
+    std::size_t run{firstRun()};
+    std::size_t index{algorithms::simd::find(data(_head), run, value)};
+    if (index < run) {
+      return index;
+    }
+    return run + algorithms::simd::find(data(0), _size - run, value);
+  }
+
+  std::size_t count(const_reference value) const {
+    std::size_t run{firstRun()};
+    return algorithms::simd::count(data(_head), run, value) +
+           algorithms::simd::count(data(0), _size - run, value);
+  }
+
+  // index of the first smallest element, 0 when empty
+  std::size_t min_element() const { return extremeElement<true>(); }
+  // index of the first largest element, 0 when empty
+  std::size_t max_element() const { return extremeElement<false>(); }
+
+  // overwrites every element, the size stays
+  void fill(const_reference value) {
+    std::size_t run{firstRun()};
+    algorithms::simd::fill(_elements.data() + _head, run, value);
+    algorithms::simd::fill(_elements.data(), _size - run, value);
+  }
+
   iterator begin() { return {_head, this}; }
   iterator end() { return {_tail, this, _size}; }
 
@@ -292,6 +356,31 @@ public:
   const_iterator cend() const { return {_tail, this, _size}; }
 
 private:
+  const T* data(std::size_t physicalIndex) const {
+    return _elements.data() + physicalIndex;
+  }
+
+  // elements from _head up to the end of storage, the rest wrap to index 0
+  std::size_t firstRun() const noexcept {
+    return _size < N - _head ? _size : N - _head;
+  }
+
+  template <bool Less> std::size_t extremeElement() const {
+    std::size_t run{firstRun()};
+    std::size_t first{Less ? algorithms::simd::min_element(data(_head), run)
+                           : algorithms::simd::max_element(data(_head), run)};
+    if (run == _size) {
+      return first;
+    }
+    std::size_t second{
+        Less ? algorithms::simd::min_element(data(0), _size - run)
+             : algorithms::simd::max_element(data(0), _size - run)};
+    const T& a{*data(_head + first)};
+    const T& b{*data(second)};
+    // ties go to the first run, it is the older one
+    return (Less ? b < a : a < b) ? run + second : first;
+  }
+
   void validateIndex(std::size_t index) {
     if (_size > 0 && index >= _size) {
       throw OutOfRangeException{"Index out of range"};
@@ -1,13 +1,17 @@
 #pragma once
 
 #include <algorithm>
+#include <allocator.hpp>
 #include <circular-buffer.hpp>
 #include <cmath>
 #include <concept.hpp>
 #include <cstddef>
 #include <initializer_list>
+#include <iterator>
 #include <simple-deque.hpp>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #define DEQUE_DEBUG 0
@@ -23,9 +27,19 @@
   } while (0)
 #endif
 
-template <typename T> class Deque {
-  inline static constexpr std::size_t DEFAULT_DEQUE_BUFFER_SIZE{4096};
+inline constexpr std::size_t DEFAULT_DEQUE_BUFFER_SIZE{4096};
+
+// Elements live in blocks of BlockBytes (16 elements if T is bigger), e.g.
+// 64 KiB blocks for long sequential scans or a cache line for tiny queues.
+// Emptied blocks stay in the map on either side of the elements and are
+// reused when the other end needs a new block, so a queue at a steady depth
+// (push_back + pop_front) stops allocating once it is warm. Up to
+// MAX_SPARE_BLOCKS are kept on each side, shrink_to_fit frees them.
+template <typename T, typename Allocator = Allocator<T>,
+          std::size_t BlockBytes = DEFAULT_DEQUE_BUFFER_SIZE>
+class Deque {
   inline static constexpr std::size_t DEFAULT_DEQUE_MAP_MIN_SIZE{2};
+  inline static constexpr std::size_t MAX_SPARE_BLOCKS{4};
 
 public:
   class Iterator;
@@ -40,16 +54,15 @@ public:
   using reference = value_type&;
   using rvalue_reference = value_type&&;
   using const_reference = const value_type&;
-  using self = Deque<T>;
+  using self = Deque<T, Allocator, BlockBytes>;
 
 private:
   inline constexpr static std::size_t _chunk_size{
-      sizeof(T) > DEFAULT_DEQUE_BUFFER_SIZE
-          ? 16
-          : DEFAULT_DEQUE_BUFFER_SIZE / sizeof(T)};
+      sizeof(T) > BlockBytes ? 16 : BlockBytes / sizeof(T)};
 
-  using buffer = CircularBuffer<value_type, _chunk_size>;
-  using map = SimpleDeque<buffer>;
+  using buffer = CircularBuffer<value_type, _chunk_size, Allocator>;
+  using map =
+      SimpleDeque<buffer, typename Allocator::template rebind<buffer>::other>;
 
   map _map;
   std::size_t _size{};
@@ -120,13 +133,46 @@ public:
   iterator cbegin() const { return _head; };
   iterator cend() const { return _tail; };
 
+  /* Segments */
+  template <bool IsConst> class Segments;
+
+  // the elements as the contiguous runs they occupy in the blocks, front to
+  // back, at most two per block. Loops over them skip the block boundary
+  // checks of iterator::operator++.
+  Segments<false> segments() { return Segments<false>{this}; };
+  Segments<true> segments() const { return Segments<true>{this}; };
+
+  // calls fn with every run of segments()
+  template <typename Fn> void for_each_segment(Fn&& fn) {
+    if (empty()) {
+      return;
+    }
+    for (std::size_t block{_head._blockIndex}; block <= _tail._blockIndex;
+         ++block) {
+      _map[block].for_each_segment(fn);
+    }
+  }
+  template <typename Fn> void for_each_segment(Fn&& fn) const {
+    if (empty()) {
+      return;
+    }
+    for (std::size_t block{_head._blockIndex}; block <= _tail._blockIndex;
+         ++block) {
+      _map[block].for_each_segment(fn);
+    }
+  }
+
   /* Capacity */
   bool empty() const noexcept { return _size == 0; };
   bool is_full() const noexcept {
     return _map.capacity() * _chunk_size == _size;
   };
   std::size_t size() const noexcept { return _size; };
-  void shrink_to_fit();
+  // frees the spare blocks kept for reuse
+  void shrink_to_fit() {
+    release_spare_left_blocks(0);
+    release_spare_right_blocks(0);
+  };
 
   /* Element access */
   reference operator[](std::size_t index) {
@@ -254,8 +300,9 @@ public:
   value_type pop_front() {
     buffer& headBlock{_map[_head._blockIndex]};
     value_type ele{headBlock.pop_front()};
-    if (headBlock.empty() && _head._blockIndex < _map.size() - 1) {
+    if (headBlock.empty() && _head._blockIndex < _tail._blockIndex) {
       ++_head._blockIndex;
+      release_spare_left_blocks(MAX_SPARE_BLOCKS);
     } else if (_head._blockIndex == _tail._blockIndex) {
       --_tail._currentIndex;
     }
@@ -265,9 +312,11 @@ public:
   value_type pop_back() {
     buffer& tailBlock{_map[_tail._blockIndex]};
     value_type ele{tailBlock.pop_back()};
-    if (tailBlock.empty() && _tail._blockIndex > 0) {
+    if (tailBlock.empty() && _tail._blockIndex > _head._blockIndex) {
       --_tail._blockIndex;
-      _tail._currentIndex = _chunk_size;
+      // the head block may be the new tail and need not be full
+      _tail._currentIndex = _map[_tail._blockIndex].size();
+      release_spare_right_blocks(MAX_SPARE_BLOCKS);
     } else {
       --_tail._currentIndex;
     }
@@ -316,12 +365,28 @@ private:
 
   buffer pop_or_make_spare_left_block() {
     if (_head._blockIndex != 0 && _map.front().capacity()) {
+      --_head._blockIndex;
       --_tail._blockIndex;
       return _map.pop_front();
     }
     return buffer();
   }
 
+  // the blocks left of the head and right of the tail are empty spares
+  void release_spare_left_blocks(std::size_t keep) {
+    while (_head._blockIndex > keep) {
+      _map.pop_front();
+      --_head._blockIndex;
+      --_tail._blockIndex;
+    }
+  }
+
+  void release_spare_right_blocks(std::size_t keep) {
+    while (_map.size() - 1 - _tail._blockIndex > keep) {
+      _map.pop_back();
+    }
+  }
+
   buffer pop_or_make_spare_right_block() {
     return _tail._blockIndex != _map.size() - 1 && _map.back().capacity()
                ? _map.pop_back()
@@ -344,6 +409,9 @@ public:
   public:
     using iterator_category = Deque::iterator_category;
     using difference_type = Deque::difference_type;
+    using value_type = Deque::value_type;
+    using pointer = Deque::pointer;
+    using reference = Deque::reference;
 
   public:
     Iterator() = default;
@@ -351,13 +419,22 @@ public:
   private:
     std::size_t _blockIndex{};
     std::size_t _currentIndex{};
-    const Deque<T>* _deque_ptr{};
+    const self* _deque_ptr{};
 
-    Iterator(std::size_t blockIndex, std::size_t currentIndex,
-             Deque<T>* deque_ptr)
+    Iterator(std::size_t blockIndex, std::size_t currentIndex, self* deque_ptr)
         : _blockIndex{blockIndex}, _currentIndex{currentIndex},
           _deque_ptr{deque_ptr} {};
 
+    // index from the front, the blocks after the head block are full
+    std::size_t position() const {
+      std::size_t headBlock{_deque_ptr->_head._blockIndex};
+      if (_blockIndex == headBlock) {
+        return _currentIndex;
+      }
+      return _deque_ptr->_map[headBlock].size() +
+             (_blockIndex - headBlock - 1) * _chunk_size + _currentIndex;
+    }
+
   public:
     reference operator*() {
       return _deque_ptr->_map[_blockIndex][_currentIndex];
@@ -445,8 +522,8 @@ public:
     }
 
     difference_type operator-(const Iterator& other) const {
-      return _blockIndex * _chunk_size + _currentIndex -
-             (other._blockIndex * other._chunk_size + other._currentIndex);
+      return static_cast<difference_type>(position()) -
+             static_cast<difference_type>(other.position());
     }
 
     bool operator==(const Iterator& other) const {
@@ -477,4 +554,82 @@ public:
       return *this;
     }
   };
+  template <bool IsConst> class Segments {
+    friend class Deque;
+
+    using deque_pointer = std::conditional_t<IsConst, const self*, self*>;
+
+    deque_pointer _deque_ptr{};
+
+    explicit Segments(deque_pointer deque_ptr) : _deque_ptr{deque_ptr} {};
+
+  public:
+    class Iterator {
+      friend class Segments;
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using difference_type = Deque::difference_type;
+      using value_type = std::span<std::conditional_t<IsConst, const T, T>>;
+
+      Iterator() = default;
+
+    private:
+      deque_pointer _deque_ptr{};
+      std::size_t _blockIndex{};
+      // which of the block's two runs
+      std::size_t _part{};
+
+      Iterator(deque_pointer deque_ptr, std::size_t blockIndex)
+          : _deque_ptr{deque_ptr}, _blockIndex{blockIndex} {};
+
+      void step() {
+        if (++_part == 2) {
+          _part = 0;
+          ++_blockIndex;
+        }
+      }
+
+      void skipEmpty() {
+        while (_blockIndex <= _deque_ptr->_tail._blockIndex &&
+               (**this).empty()) {
+          step();
+        }
+      }
+
+    public:
+      value_type operator*() const {
+        return _deque_ptr->_map[_blockIndex].segments()[_part];
+      };
+
+      Iterator& operator++() {
+        step();
+        skipEmpty();
+        return *this;
+      }
+
+      Iterator operator++(int) {
+        Iterator tmp{*this};
+        ++(*this);
+        return tmp;
+      }
+
+      bool operator==(const Iterator& other) const {
+        return _blockIndex == other._blockIndex && _part == other._part;
+      }
+    };
+
+    Iterator begin() const {
+      if (_deque_ptr->empty()) {
+        return end();
+      }
+      Iterator first{_deque_ptr, _deque_ptr->_head._blockIndex};
+      first.skipEmpty();
+      return first;
+    };
+    Iterator end() const {
+      return {_deque_ptr,
+              _deque_ptr->empty() ? 0 : _deque_ptr->_tail._blockIndex + 1};
+    };
+  };
 };
\ No newline at end of file
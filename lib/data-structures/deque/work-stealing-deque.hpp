@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// Chase-Lev work stealing deque, with the memory orderings of Le et al.,
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (2013).
+// One owner thread pushes and pops at the bottom, LIFO, so it keeps working on
+// what is hot in its cache. Any number of thief threads steal the oldest
+// element from the top with a CAS.
+// The elements live in a circular array that the owner doubles when it is
+// full. A thief may still be reading the old array, so replaced arrays are
+// kept until the deque is destroyed; together they are never bigger than the
+// current one.
+// T is copied in and out of atomics, so it must be trivially copyable, e.g. a
+// pointer to a task.
+template <typename T> class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "WorkStealingDeque elements are copied through atomics");
+
+  // same size as a Deque block
+  inline static constexpr std::size_t DEFAULT_RING_BYTES{4096};
+  inline static constexpr std::size_t CACHE_LINE{64};
+
+  struct Ring {
+    std::int64_t _capacity;
+    std::int64_t _mask;
+    std::unique_ptr<std::atomic<T>[]> _slots;
+    // older ring, only touched by the owner
+    Ring* _retired{nullptr};
+
+    explicit Ring(std::int64_t capacity)
+        : _capacity{capacity}, _mask{capacity - 1},
+          _slots{new std::atomic<T>[static_cast<std::size_t>(capacity)]} {}
+
+    // rings are only handed around by pointer
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+
+    T get(std::int64_t index) const {
+      return _slots[static_cast<std::size_t>(index & _mask)].load(
+          std::memory_order_relaxed);
+    }
+
+    void put(std::int64_t index, T value) {
+      _slots[static_cast<std::size_t>(index & _mask)].store(
+          value, std::memory_order_relaxed);
+    }
+  };
+
+  static std::int64_t initial_capacity(std::size_t capacity) {
+    std::size_t rounded{2};
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    return static_cast<std::int64_t>(rounded);
+  }
+
+  // top and bottom are written by different threads, keep them on their own
+  // cache lines
+  alignas(CACHE_LINE) std::atomic<std::int64_t> _top{0};
+  alignas(CACHE_LINE) std::atomic<std::int64_t> _bottom{0};
+  alignas(CACHE_LINE) std::atomic<Ring*> _ring;
+
+  Ring* grow(Ring* ring, std::int64_t bottom, std::int64_t top) {
+    Ring* bigger{new Ring{ring->_capacity * 2}};
+    for (std::int64_t i{top}; i < bottom; ++i) {
+      bigger->put(i, ring->get(i));
+    }
+    bigger->_retired = ring;
+    _ring.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+public:
+  using value_type = T;
+
+  explicit WorkStealingDeque(
+      std::size_t capacity = DEFAULT_RING_BYTES / sizeof(T))
+      : _ring{new Ring{initial_capacity(capacity)}} {}
+
+  ~WorkStealingDeque() {
+    Ring* ring{_ring.load(std::memory_order_relaxed)};
+    while (ring) {
+      delete std::exchange(ring, ring->_retired);
+    }
+  }
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  /* Owner */
+  void push(T value) {
+    std::int64_t bottom{_bottom.load(std::memory_order_relaxed)};
+    std::int64_t top{_top.load(std::memory_order_acquire)};
+    Ring* ring{_ring.load(std::memory_order_relaxed)};
+    if (bottom - top > ring->_capacity - 1) {
+      ring = grow(ring, bottom, top);
+    }
+    ring->put(bottom, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  // newest element, empty if there is none or a thief took the last one
+  std::optional<T> pop() {
+    std::int64_t bottom{_bottom.load(std::memory_order_relaxed) - 1};
+    Ring* ring{_ring.load(std::memory_order_relaxed)};
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top{_top.load(std::memory_order_relaxed)};
+
+    std::optional<T> result{};
+    if (top <= bottom) {
+      result = ring->get(bottom);
+      if (top == bottom) {
+        // last element, race the thieves for it
+        if (!_top.compare_exchange_strong(top, top + 1,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+          result.reset();
+        }
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+      }
+    } else {
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  /* Thieves */
+  // oldest element, empty if there is none or another thread got it first
+  std::optional<T> steal() {
+    std::int64_t top{_top.load(std::memory_order_acquire)};
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom{_bottom.load(std::memory_order_acquire)};
+    if (top >= bottom) {
+      return std::nullopt;
+    }
+    Ring* ring{_ring.load(std::memory_order_acquire)};
+    T value{ring->get(top)};
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  /* Capacity */
+  // only a snapshot while other threads are working on it
+  std::size_t size() const {
+    std::int64_t bottom{_bottom.load(std::memory_order_relaxed)};
+    std::int64_t top{_top.load(std::memory_order_relaxed)};
+    return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+  }
+  bool empty() const { return size() == 0; }
+
+  std::size_t capacity() const {
+    return static_cast<std::size_t>(
+        _ring.load(std::memory_order_relaxed)->_capacity);
+  }
+};
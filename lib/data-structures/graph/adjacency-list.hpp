@@ -1,10 +1,13 @@
 #pragma once
 
+#include <allocator.hpp>
+#include <concept.hpp>
 #include <functional>
 #include <graph.hpp>
 #include <list.hpp>
 #include <queue.hpp>
 #include <stack.hpp>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector.hpp>
@@ -14,7 +17,14 @@ namespace graphs {
 // memory efficient
 // faster insert time compared to AdjacencyMatrix
 // need good hash function
-template <typename V, typename E = int> class AdjacencyList {
+template <typename V, typename E = int,
+          concepts::Allocator Allocator = Allocator<V>>
+class AdjacencyList {
+  // arena backed vertices holding trivially destructible data own nothing,
+  // they are reclaimed when the arena is released
+  inline static constexpr bool skipVertexDestruction{
+      concepts::MonotonicAllocator<Allocator> &&
+      std::is_trivially_destructible_v<V>};
 
 public:
   class Vertex {
@@ -25,6 +35,17 @@ public:
 
     Vertex(const V& value) : data{value} {};
     Vertex(V&& value) : data{std::move(value)} {};
+
+    void* operator new(std::size_t) {
+      typename Allocator::template rebind<Vertex>::other alloc{};
+      return static_cast<void*>(alloc.allocate(1));
+    }
+
+    void operator delete(void* p, std::size_t) {
+      typename Allocator::template rebind<Vertex>::other alloc{};
+      alloc.deallocate(static_cast<Vertex*>(p), 1);
+      return;
+    }
   };
 
   struct Edge {
@@ -88,6 +109,9 @@ public:
   }
 
   ~AdjacencyList() {
+    if (skipVertexDestruction) {
+      return;
+    }
     for (Vertex* v : _vertices) {
       delete v;
     }
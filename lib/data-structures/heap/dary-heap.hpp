@@ -0,0 +1,214 @@
+#pragma once
+
+#include <concept.hpp>
+#include <cstddef>
+#include <helpers.hpp>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector.hpp>
+
+#define DARY_HEAP_DEBUG 0
+
+#if DARY_HEAP_DEBUG == 1
+#define DARY_HEAP_DEBUG_MS(mes)                                                \
+  do {                                                                         \
+    helpers::printf(mes);                                                      \
+  } while (0)
+#else
+#define DARY_HEAP_DEBUG_MS(mes)                                                \
+  do {                                                                         \
+  } while (0)
+#endif
+
+// Heap where every node has Arity children, stored breadth first like Heap.
+// The tree is log2(Arity) times shallower, and the children of a node are
+// Arity consecutive elements, so a pop touches fewer cache lines: 4 or 8
+// ints, or 4 pointers, fit one line. push gets cheaper with the height, pop
+// compares up to Arity children per level instead of 2.
+// Sifts are loops that move a hole instead of swapping, one move per level,
+// and pop walks the hole to a leaf before placing the last element.
+template <concepts::Comparable T, std::size_t Arity = 4,
+          typename Comparator = std::less_equal<T>>
+class DaryHeap {
+  static_assert(Arity >= 2, "a heap node needs at least two children");
+
+private:
+  Vector<T> _container{};
+  static constexpr Comparator compFn{};
+
+public:
+  using value_type = T;
+  using pointer = value_type*;
+  using reference = value_type&;
+  using rvalue_reference = value_type&&;
+  using const_reference = const value_type&;
+  using self = DaryHeap<T, Arity, Comparator>;
+
+  DaryHeap() = default;
+
+  DaryHeap(std::initializer_list<T> list) : _container(list) {
+    DARY_HEAP_DEBUG_MS("DARY_HEAP List Ctor");
+    heapify();
+  };
+
+  template <std::random_access_iterator Iterator>
+  DaryHeap(Iterator begin, Iterator end) : _container(begin, end) {
+    heapify();
+  }
+
+  ~DaryHeap() { DARY_HEAP_DEBUG_MS("DARY_HEAP Dtor"); };
+
+  DaryHeap(const self& other) : _container{other._container} {
+    DARY_HEAP_DEBUG_MS("DARY_HEAP Copy Ctor");
+  };
+
+  DaryHeap(self&& other) noexcept : _container{std::move(other._container)} {
+    DARY_HEAP_DEBUG_MS("DARY_HEAP Move Ctor");
+  };
+
+  self& operator=(const self& other) {
+    DARY_HEAP_DEBUG_MS("DARY_HEAP Copy Operator");
+    self copy{other};
+    copy.swap(*this);
+    return *this;
+  };
+
+  self& operator=(self&& other) noexcept {
+    DARY_HEAP_DEBUG_MS("DARY_HEAP Move Operator");
+    self move{std::move(other)};
+    move.swap(*this);
+    return *this;
+  };
+
+  void swap(self& other) noexcept {
+    using std::swap;
+    swap(_container, other._container);
+  }
+
+  void friend swap(self& e1, self& e2) noexcept { e1.swap(e2); };
+
+  bool empty() const noexcept { return _container.empty(); }
+  std::size_t size() const noexcept { return _container.size(); }
+
+  reference top() noexcept { return _container.front(); }
+
+  void push(const_reference data) {
+    _container.push_back(data);
+    move_up(_container.size() - 1);
+  }
+
+  void push(rvalue_reference data) {
+    _container.push_back(std::move(data));
+    move_up(_container.size() - 1);
+  }
+
+  value_type pop() {
+    value_type last{_container.pop_back()};
+    if (_container.empty()) {
+      return last;
+    }
+    value_type top{std::move(_container[0])};
+    // the last element nearly always belongs near the bottom: walk the hole
+    // down to a leaf without comparing against it, then sift it up from
+    // there. That saves a compare per level on the way down.
+    std::size_t index{move_hole_down(0)};
+    _container[index] = std::move(last);
+    move_up(index);
+    return top;
+  }
+
+  value_type remove(std::size_t index) {
+    value_type last{_container.pop_back()};
+    if (index == _container.size()) {
+      return last;
+    }
+    value_type removed{std::move(_container[index])};
+    _container[index] = std::move(last);
+    // the last element may belong above or below index
+    if (index != 0 && compFn(_container[index],
+                             _container[parent_index(index)])) {
+      move_up(index);
+    } else {
+      move_down(index);
+    }
+    return removed;
+  }
+
+private:
+  static std::size_t parent_index(std::size_t index) {
+    return (index - 1) / Arity;
+  }
+  static std::size_t first_child_index(std::size_t index) {
+    return index * Arity + 1;
+  }
+
+  void heapify() {
+    if (_container.size() < 2) {
+      return;
+    }
+    // from the parent of the last element back to the root
+    for (std::size_t i{parent_index(_container.size() - 1) + 1}; i-- > 0;) {
+      move_down(i);
+    }
+  }
+
+  void move_up(std::size_t index) {
+    value_type value{std::move(_container[index])};
+    while (index != 0) {
+      std::size_t parentIndex{parent_index(index)};
+      if (!compFn(value, _container[parentIndex])) {
+        break;
+      }
+      _container[index] = std::move(_container[parentIndex]);
+      index = parentIndex;
+    }
+    _container[index] = std::move(value);
+  }
+
+  // the child of index that belongs on top, index must have children
+  std::size_t best_child_index(std::size_t index) const {
+    std::size_t size{_container.size()};
+    std::size_t firstChild{first_child_index(index)};
+    std::size_t lastChild{firstChild + Arity < size ? firstChild + Arity
+                                                    : size};
+    std::size_t best{firstChild};
+    for (std::size_t child{firstChild + 1}; child < lastChild; ++child) {
+      if (!compFn(_container[best], _container[child])) {
+        best = child;
+      }
+    }
+    return best;
+  }
+
+  void move_down(std::size_t index) {
+    std::size_t size{_container.size()};
+    value_type value{std::move(_container[index])};
+    while (first_child_index(index) < size) {
+      std::size_t best{best_child_index(index)};
+      if (compFn(value, _container[best])) {
+        break;
+      }
+      _container[index] = std::move(_container[best]);
+      index = best;
+    }
+    _container[index] = std::move(value);
+  }
+
+  // moves the best children up into the hole at index down to a leaf,
+  // returns where the hole ends
+  std::size_t move_hole_down(std::size_t index) {
+    std::size_t size{_container.size()};
+    while (first_child_index(index) < size) {
+      std::size_t best{best_child_index(index)};
+      _container[index] = std::move(_container[best]);
+      index = best;
+    }
+    return index;
+  }
+};
+
+template <typename T, std::size_t Arity = 4>
+using DaryMinHeap = DaryHeap<T, Arity>;
+template <typename T, std::size_t Arity = 4>
+using DaryMaxHeap = DaryHeap<T, Arity, std::greater_equal<T>>;
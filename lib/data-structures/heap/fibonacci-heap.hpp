@@ -61,8 +61,8 @@ private:
 
     template <concepts::IsSameBase<Key> K, concepts::IsSameBase<Value> V>
     Node(K&& key, V&& value)
-        : _left{this}, _right{this}, _key{std::forward<Key>(key)},
-          _value{std::forward<Value>(value)} {}
+        : _left{this}, _right{this}, _key{std::forward<K>(key)},
+          _value{std::forward<V>(value)} {}
 
     ~Node() {}
 
@@ -72,14 +72,14 @@ private:
     Node(Node&& other) = default;
     Node& operator=(Node&& other) = default;
 
-    void* operator new(std::size_t size) {
+    void* operator new(std::size_t) {
       typename Allocator::template rebind<Node>::other alloc{};
-      return static_cast<void*>(alloc.allocate(size));
+      return static_cast<void*>(alloc.allocate(1));
     }
 
     void operator delete(void* p, std::size_t) {
       typename Allocator::template rebind<Node>::other alloc{};
-      alloc.deallocate(static_cast<Node*>(p));
+      alloc.deallocate(static_cast<Node*>(p), 1);
       return;
     }
 
@@ -92,6 +92,25 @@ private:
   Node* _minNode{nullptr};
 
 public:
+  // refers to one element, from insert until it is extracted or erased.
+  // decrease_key and erase go straight to the node instead of searching
+  // the heap for a key.
+  class Handle {
+    friend class FibonacciHeap;
+
+    Node* _node{nullptr};
+
+    explicit Handle(Node* node) : _node{node} {}
+
+  public:
+    Handle() = default;
+
+    const Key& key() const { return _node->_key; }
+    reference value() const { return _node->_value; }
+
+    bool operator==(const Handle& other) const = default;
+  };
+
   FibonacciHeap() = default;
 
   ~FibonacciHeap() {
@@ -137,9 +156,8 @@ public:
   bool empty() const noexcept { return _numNodes == 0; }
 
   template <concepts::IsSameBase<Key> K, concepts::IsSameBase<Value> V>
-  void insert(K&& key, V&& value) {
-    _insert(std::forward<K>(key), std::forward<V>(value));
-    return;
+  Handle insert(K&& key, V&& value) {
+    return Handle{_insert(std::forward<K>(key), std::forward<V>(value))};
   }
 
   void merge(FibonacciHeap&& other) {
@@ -165,26 +183,43 @@ public:
     return result;
   }
 
+  // O(1) amortised. A key that does not come before the current one is
+  // ignored.
+  template <concepts::IsSameBase<Key> K>
+  void decrease_key(Handle handle, K&& newKey) {
+    _minNode = _update_key(_minNode, handle._node, std::forward<K>(newKey));
+  }
+
+  // O(log n) amortised
+  void erase(Handle handle) {
+    Node* node{handle._node};
+    Node* parent{node->_parent};
+    if (parent) {
+      _minNode = _cut(_minNode, node);
+      _minNode = _cascade_cut(_minNode, parent);
+    }
+    // node is a root now, extract it as if it were the top
+    _minNode = node;
+    extract_top();
+  }
+
+  // O(n) search for oldKey, prefer decrease_key with the handle from insert
   template <concepts::IsSameBase<Key> K>
   void update_key(const Key& oldkey, K&& newKey) {
     Node* node{_find(_minNode, oldkey)};
     if (!node) {
       return;
     }
-    _minNode = _update_key(_minNode, node, std::forward<K>(newKey));
-    return;
+    decrease_key(Handle{node}, std::forward<K>(newKey));
   }
 
+  // O(n) search for key, prefer erase with the handle from insert
   void delete_key(const Key& key) {
     Node* node{_find(_minNode, key)};
     if (!node) {
       return;
     }
-    Node* oldMin{_minNode};
-    _update_key(_minNode, node, _minNode->_key);
-    _minNode = node;
-    extract_top();
-    _minNode = oldMin;
+    erase(Handle{node});
   }
 
 private:
@@ -212,6 +247,7 @@ private:
   // current min node and return new min node while ensuring that no tree has
   // the same degree
   Node* _extract_top(Node* node) {
+    --_numNodes;
     // break the link between this node and its subtree
     _unmark_and_unparent_all(node->_child);
     if (node->is_single_child()) {
@@ -230,7 +266,6 @@ private:
     }
 
     node = _consolidate(node);
-    --_numNodes;
 
     // find the new min
     Node* newMin{node};
@@ -246,11 +281,11 @@ private:
 
   Node* _consolidate(Node* node) {
     // get maximum degree in a heap with n nodes
-    // maximum degree of heap(n) is log2(n)
+    // maximum degree of heap(n) is log_phi(n), phi the golden ratio
     // to find log of a to any base b we divide log: log(a) / log(b) = logb(a)
     // log(n) is natural log
-    std::size_t maxDegree{
-        static_cast<std::size_t>(std::log(_numNodes) / std::log(2))};
+    std::size_t maxDegree{static_cast<std::size_t>(
+        std::log(_numNodes + 1) / std::log((1 + std::sqrt(5.0)) / 2))};
     std::vector<Node*> trees(maxDegree + 1, nullptr);
 
     while (true) {
@@ -369,7 +404,7 @@ private:
     Node* newNode{_create_node(std::forward<K>(key), std::forward<V>(value))};
     ++_numNodes;
     _minNode = _merge(_minNode, newNode);
-    return _minNode;
+    return newNode;
   }
 
   Node* _merge(Node* root1, Node* root2) {
@@ -115,7 +115,11 @@ public:
   value_type remove(std::size_t index) {
     std::swap(_container[index], _container.back());
     value_type removedEle{_container.pop_back()};
-    move_down(index);
+    if (index < _container.size()) {
+      // the former last element may belong above or below index
+      move_up(index);
+      move_down(index);
+    }
     return removedEle;
   }
 
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <concept.hpp>
+#include <cstddef>
+#include <helpers.hpp>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector.hpp>
+
+#define INDEXED_HEAP_DEBUG 0
+
+#if INDEXED_HEAP_DEBUG == 1
+#define INDEXED_HEAP_DEBUG_MS(mes)                                             \
+  do {                                                                         \
+    helpers::printf(mes);                                                      \
+  } while (0)
+#else
+#define INDEXED_HEAP_DEBUG_MS(mes)                                             \
+  do {                                                                         \
+  } while (0)
+#endif
+
+// Binary heap of ids, each with a priority, for elements that already have
+// a dense integer id: vertices of a graph, slots of a timer wheel.
+// Next to the heap it keeps the position of every id in it, so an element
+// is found in O(1) instead of Heap::remove's linear scan. That makes
+// contains O(1), and update (change priority either way) and erase
+// O(log n), on top of push and pop.
+// The position map grows to the largest id pushed, so ids should be
+// small; size the map up front with the constructor.
+//
+//   IndexedHeap<long long> frontier{vertexCount};
+//   frontier.push(source, 0);
+//   ...
+//   frontier.push(to, candidate); // adds to or moves it up
+template <concepts::Comparable Priority,
+          typename Comparator = std::less_equal<Priority>>
+class IndexedHeap {
+  inline static constexpr std::size_t ABSENT{
+      std::numeric_limits<std::size_t>::max()};
+
+  struct Entry {
+    std::size_t _id;
+    Priority _priority;
+  };
+
+  Vector<Entry> _entries{};
+  // position of every id in _entries, ABSENT when not in the heap
+  Vector<std::size_t> _positions{};
+  static constexpr Comparator compFn{};
+
+public:
+  using value_type = Priority;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using self = IndexedHeap<Priority, Comparator>;
+
+  class OutOfRangeException : public std::exception {
+    using std::exception::what;
+
+  private:
+    std::string message;
+
+  public:
+    OutOfRangeException(std::string msg) : message{msg} {}
+    std::string what() { return message; }
+  };
+
+  // ids below idCount need no map growth
+  explicit IndexedHeap(std::size_t idCount = 0) : _positions(idCount) {
+    for (std::size_t i{}; i < idCount; ++i) {
+      _positions.push_back(ABSENT);
+    }
+  }
+
+  ~IndexedHeap() { INDEXED_HEAP_DEBUG_MS("INDEXED_HEAP Dtor"); };
+
+  IndexedHeap(const self& other) = default;
+  IndexedHeap(self&& other) noexcept = default;
+
+  self& operator=(const self& other) {
+    self copy{other};
+    copy.swap(*this);
+    return *this;
+  };
+
+  self& operator=(self&& other) noexcept {
+    self move{std::move(other)};
+    move.swap(*this);
+    return *this;
+  };
+
+  void swap(self& other) noexcept {
+    using std::swap;
+    swap(_entries, other._entries);
+    swap(_positions, other._positions);
+  }
+
+  void friend swap(self& e1, self& e2) noexcept { e1.swap(e2); };
+
+  /* Capacity */
+  bool empty() const noexcept { return _entries.empty(); }
+  std::size_t size() const noexcept { return _entries.size(); }
+
+  /* Lookup */
+  bool contains(std::size_t id) const noexcept {
+    return id < _positions.size() && _positions[id] != ABSENT;
+  }
+
+  // the id on top
+  std::size_t top() const { return _entries[0]._id; }
+
+  const_reference priority(std::size_t id) const {
+    validateId(id);
+    return _entries[_positions[id]]._priority;
+  }
+
+  /* Modifiers */
+  // adds id, or gives it the new priority if it is already in the heap
+  void push(std::size_t id, const_reference priority) {
+    if (contains(id)) {
+      update(id, priority);
+      return;
+    }
+    while (_positions.size() <= id) {
+      _positions.push_back(ABSENT);
+    }
+    _entries.push_back(Entry{id, priority});
+    _positions[id] = _entries.size() - 1;
+    move_up(_entries.size() - 1);
+  }
+
+  // removes the top, returns its id and priority
+  std::pair<std::size_t, Priority> pop() {
+    Entry top{remove(0)};
+    return {top._id, std::move(top._priority)};
+  }
+
+  // moves id up or down to its new priority
+  void update(std::size_t id, const_reference priority) {
+    validateId(id);
+    std::size_t index{_positions[id]};
+    _entries[index]._priority = priority;
+    restore(index);
+  }
+
+  void erase(std::size_t id) {
+    validateId(id);
+    remove(_positions[id]);
+  }
+
+  void clear() {
+    for (Entry& entry : _entries) {
+      _positions[entry._id] = ABSENT;
+    }
+    _entries.clear();
+  }
+
+private:
+  static std::size_t parent_index(std::size_t index) {
+    return (index - 1) / 2;
+  }
+  static std::size_t left_child_index(std::size_t index) {
+    return index * 2 + 1;
+  }
+
+  void validateId(std::size_t id) const {
+    if (!contains(id)) {
+      throw OutOfRangeException{"id is not in the heap"};
+    }
+  }
+
+  void place(std::size_t index, Entry&& entry) {
+    _positions[entry._id] = index;
+    _entries[index] = std::move(entry);
+  }
+
+  Entry remove(std::size_t index) {
+    Entry removed{std::move(_entries[index])};
+    _positions[removed._id] = ABSENT;
+    Entry last{_entries.pop_back()};
+    if (index < _entries.size()) {
+      place(index, std::move(last));
+      restore(index);
+    }
+    return removed;
+  }
+
+  // sifts the entry at index whichever way its priority says
+  void restore(std::size_t index) {
+    if (index != 0 && compFn(_entries[index]._priority,
+                             _entries[parent_index(index)]._priority)) {
+      move_up(index);
+    } else {
+      move_down(index);
+    }
+  }
+
+  void move_up(std::size_t index) {
+    Entry entry{std::move(_entries[index])};
+    while (index != 0) {
+      std::size_t parentIndex{parent_index(index)};
+      if (!compFn(entry._priority, _entries[parentIndex]._priority)) {
+        break;
+      }
+      place(index, std::move(_entries[parentIndex]));
+      index = parentIndex;
+    }
+    place(index, std::move(entry));
+  }
+
+  void move_down(std::size_t index) {
+    std::size_t size{_entries.size()};
+    Entry entry{std::move(_entries[index])};
+    while (left_child_index(index) < size) {
+      std::size_t child{left_child_index(index)};
+      if (child + 1 < size &&
+          !compFn(_entries[child]._priority, _entries[child + 1]._priority)) {
+        ++child;
+      }
+      if (compFn(entry._priority, _entries[child]._priority)) {
+        break;
+      }
+      place(index, std::move(_entries[child]));
+      index = child;
+    }
+    place(index, std::move(entry));
+  }
+};
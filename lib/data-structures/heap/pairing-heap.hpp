@@ -0,0 +1,325 @@
+#pragma once
+
+#include <allocator.hpp>
+#include <concept.hpp>
+#include <cstddef>
+#include <helpers.hpp>
+#include <utility>
+#include <vector.hpp>
+
+#define PAIRING_HEAP_DEBUG 0
+
+#if PAIRING_HEAP_DEBUG == 1
+#define PAIRING_HEAP_DEBUG_MS(mes)                                             \
+  do {                                                                         \
+    helpers::printf(mes);                                                      \
+  } while (0)
+#else
+#define PAIRING_HEAP_DEBUG_MS(mes)                                             \
+  do {                                                                         \
+  } while (0)
+#endif
+
+// Heap-ordered tree where every node keeps its children in a singly linked
+// list: a node is its key, value and three pointers (leftmost child, next
+// sibling, and previous sibling or parent), against FibonacciHeap's four
+// pointers, degree and mark.
+// insert, merge and decrease_key link two trees with one comparison, the
+// loser becoming the winner's leftmost child. extract_top merges the root's
+// children in two passes: pairs left to right, then the pairs right to
+// left into one tree. No degree table is built, nothing is allocated but
+// the node itself. extract_top and erase are O(log n) amortised,
+// decrease_key below that, and in practice it usually beats FibonacciHeap.
+// Nodes come from Allocator rebound to the node type, so a PoolAllocator
+// keeps them in a node pool.
+//
+//   PairingHeap<long long, int> frontier{};
+//   auto handle = frontier.insert(10LL, vertex);
+//   frontier.decrease_key(handle, 4LL);
+//   auto [distance, closest] = frontier.extract_top();
+template <concepts::Comparable Key, typename Value,
+          typename Comparator = std::less_equal<Key>,
+          concepts::Allocator Allocator = Allocator<Key>>
+class PairingHeap {
+private:
+  static constexpr Comparator compFn{};
+
+public:
+  using value_type = Value;
+  using pointer = value_type*;
+  using reference = value_type&;
+  using rvalue_reference = value_type&&;
+  using const_reference = const value_type&;
+  using self = PairingHeap<Key, Value, Comparator, Allocator>;
+
+private:
+  class Node {
+    friend class PairingHeap;
+
+    Node* _child{nullptr}; // leftmost child
+    Node* _next{nullptr};  // next sibling
+    Node* _prev{nullptr};  // previous sibling, the parent for the leftmost
+
+    Key _key{};
+    Value _value{};
+
+  public:
+    Node() = default;
+
+    template <concepts::IsSameBase<Key> K, concepts::IsSameBase<Value> V>
+    Node(K&& key, V&& value)
+        : _key{std::forward<K>(key)}, _value{std::forward<V>(value)} {}
+
+    // the links belong to the heap, a node is never copied or moved
+    Node(const Node& other) = delete;
+    Node& operator=(const Node& other) = delete;
+    Node(Node&& other) = delete;
+    Node& operator=(Node&& other) = delete;
+
+    void* operator new(std::size_t) {
+      typename Allocator::template rebind<Node>::other alloc{};
+      return static_cast<void*>(alloc.allocate(1));
+    }
+
+    void operator delete(void* p, std::size_t) {
+      typename Allocator::template rebind<Node>::other alloc{};
+      alloc.deallocate(static_cast<Node*>(p), 1);
+    }
+  };
+
+  Node* _root{nullptr};
+  std::size_t _size{};
+
+public:
+  // refers to one element, from insert until it is extracted or erased
+  class Handle {
+    friend class PairingHeap;
+
+    Node* _node{nullptr};
+
+    explicit Handle(Node* node) : _node{node} {}
+
+  public:
+    Handle() = default;
+
+    const Key& key() const { return _node->_key; }
+    reference value() const { return _node->_value; }
+
+    bool operator==(const Handle& other) const = default;
+  };
+
+  PairingHeap() = default;
+
+  ~PairingHeap() {
+    PAIRING_HEAP_DEBUG_MS("PAIRING_HEAP Dtor");
+    _delete_all(_root);
+  };
+
+  // handles do not carry over to the copy
+  PairingHeap(const self& other)
+      : _root{_clone(other._root)}, _size{other._size} {
+    PAIRING_HEAP_DEBUG_MS("PAIRING_HEAP Copy Ctor");
+  };
+
+  PairingHeap(self&& other) noexcept
+      : _root{std::exchange(other._root, nullptr)},
+        _size{std::exchange(other._size, 0)} {
+    PAIRING_HEAP_DEBUG_MS("PAIRING_HEAP Move Ctor");
+  };
+
+  self& operator=(const self& other) {
+    PAIRING_HEAP_DEBUG_MS("PAIRING_HEAP Copy Operator");
+    self copy{other};
+    copy.swap(*this);
+    return *this;
+  };
+
+  self& operator=(self&& other) noexcept {
+    PAIRING_HEAP_DEBUG_MS("PAIRING_HEAP Move Operator");
+    self move{std::move(other)};
+    move.swap(*this);
+    return *this;
+  };
+
+  void swap(self& other) noexcept {
+    using std::swap;
+    swap(_root, other._root);
+    swap(_size, other._size);
+  }
+
+  void friend swap(self& e1, self& e2) noexcept { e1.swap(e2); };
+
+  std::size_t size() const noexcept { return _size; }
+  bool empty() const noexcept { return _size == 0; }
+
+  // O(1)
+  template <concepts::IsSameBase<Key> K, concepts::IsSameBase<Value> V>
+  Handle insert(K&& key, V&& value) {
+    Node* node{new Node{std::forward<K>(key), std::forward<V>(value)}};
+    _root = _link(_root, node);
+    ++_size;
+    return Handle{node};
+  }
+
+  // O(1), handles into other stay valid and now refer into this heap
+  void merge(self&& other) {
+    _root = _link(_root, std::exchange(other._root, nullptr));
+    _size += std::exchange(other._size, 0);
+  }
+
+  pointer top() const { return _root ? &_root->_value : nullptr; }
+
+  // O(log n) amortised, the heap must not be empty
+  std::pair<Key, Value> extract_top() {
+    Node* oldRoot{_root};
+    _root = _merge_pairs(oldRoot->_child);
+    --_size;
+    std::pair<Key, Value> result{std::move(oldRoot->_key),
+                                 std::move(oldRoot->_value)};
+    delete oldRoot;
+    return result;
+  }
+
+  // A key that does not come before the current one is ignored.
+  template <concepts::IsSameBase<Key> K>
+  void decrease_key(Handle handle, K&& newKey) {
+    Node* node{handle._node};
+    if (compFn(node->_key, newKey)) {
+      return;
+    }
+    node->_key = std::forward<K>(newKey);
+    if (node == _root) {
+      return;
+    }
+    // the subtree stays heap ordered, only its link to the parent can break
+    _detach(node);
+    _root = _link(_root, node);
+  }
+
+  // O(log n) amortised
+  void erase(Handle handle) {
+    Node* node{handle._node};
+    if (node == _root) {
+      extract_top();
+      return;
+    }
+    _detach(node);
+    _root = _link(_root, _merge_pairs(node->_child));
+    --_size;
+    delete node;
+  }
+
+  void clear() {
+    _delete_all(std::exchange(_root, nullptr));
+    _size = 0;
+  }
+
+private:
+  // joins two roots, the loser becomes the winner's leftmost child
+  Node* _link(Node* first, Node* second) {
+    if (!first) {
+      return second;
+    }
+    if (!second) {
+      return first;
+    }
+    if (!compFn(first->_key, second->_key)) {
+      std::swap(first, second);
+    }
+    second->_next = first->_child;
+    if (first->_child) {
+      first->_child->_prev = second;
+    }
+    second->_prev = first;
+    first->_child = second;
+    return first;
+  }
+
+  // unlinks the subtree at node from its parent and siblings
+  void _detach(Node* node) {
+    if (node->_prev->_child == node) {
+      node->_prev->_child = node->_next;
+    } else {
+      node->_prev->_next = node->_next;
+    }
+    if (node->_next) {
+      node->_next->_prev = node->_prev;
+    }
+    node->_next = nullptr;
+    node->_prev = nullptr;
+  }
+
+  // two-pass merge of a sibling list into one tree
+  Node* _merge_pairs(Node* first) {
+    if (!first) {
+      return nullptr;
+    }
+    // first pass: link neighbours left to right, chaining the results
+    // backwards through _prev so the second pass needs no stack
+    Node* last{nullptr};
+    while (first) {
+      Node* second{first->_next};
+      Node* rest{second ? second->_next : nullptr};
+      first->_next = first->_prev = nullptr;
+      if (second) {
+        second->_next = second->_prev = nullptr;
+      }
+      Node* pair{_link(first, second)};
+      pair->_prev = last;
+      last = pair;
+      first = rest;
+    }
+    // second pass: link the pairs right to left into one tree
+    Node* root{last};
+    last = last->_prev;
+    root->_prev = nullptr;
+    while (last) {
+      Node* previous{last->_prev};
+      last->_prev = nullptr;
+      root = _link(last, root);
+      last = previous;
+    }
+    return root;
+  }
+
+  // trees can be as deep as they are large, so walk them with a stack
+  void _delete_all(Node* root) {
+    if (!root) {
+      return;
+    }
+    Vector<Node*> pending{};
+    pending.push_back(root);
+    while (!pending.empty()) {
+      Node* node{pending.pop_back()};
+      for (Node* child{node->_child}; child; child = child->_next) {
+        pending.push_back(child);
+      }
+      delete node;
+    }
+  }
+
+  Node* _clone(const Node* root) {
+    if (!root) {
+      return nullptr;
+    }
+    Node* copy{new Node{root->_key, root->_value}};
+    Vector<std::pair<const Node*, Node*>> pending{};
+    pending.push_back({root, copy});
+    while (!pending.empty()) {
+      auto [source, target] = pending.pop_back();
+      Node* previous{target};
+      for (const Node* child{source->_child}; child; child = child->_next) {
+        Node* clone{new Node{child->_key, child->_value}};
+        clone->_prev = previous;
+        if (previous == target) {
+          target->_child = clone;
+        } else {
+          previous->_next = clone;
+        }
+        previous = clone;
+        pending.push_back({child, clone});
+      }
+    }
+    return copy;
+  }
+};
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <helpers.hpp>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector.hpp>
+
+#define RADIX_HEAP_DEBUG 0
+
+#if RADIX_HEAP_DEBUG == 1
+#define RADIX_HEAP_DEBUG_MS(mes)                                               \
+  do {                                                                         \
+    helpers::printf(mes);                                                      \
+  } while (0)
+#else
+#define RADIX_HEAP_DEBUG_MS(mes)                                               \
+  do {                                                                         \
+  } while (0)
+#endif
+
+// Min heap for monotone integer keys: no key pushed is smaller than the last
+// one popped, as in Dijkstra or an event simulation.
+// Entries sit in buckets by the highest bit where their key differs from
+// the last popped key, bucket 0 holding keys equal to it. When bucket 0
+// runs dry the first non-empty bucket is emptied into the lower ones around
+// its minimum, which becomes the new last key. An entry can only move to
+// lower buckets, so each is moved at most once per bit: push is O(1) and
+// pop amortised O(log C), C the largest key difference, with no
+// comparisons between entries and every bucket a plain array.
+//
+//   RadixHeap<std::uint64_t, int> frontier{};
+//   frontier.push(0, source);
+//   auto [distance, vertex] = frontier.pop();
+template <std::unsigned_integral Key, typename Value> class RadixHeap {
+  inline static constexpr std::size_t BUCKETS{
+      std::numeric_limits<Key>::digits + 1};
+
+public:
+  using value_type = std::pair<Key, Value>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using self = RadixHeap<Key, Value>;
+
+private:
+  Vector<value_type> _buckets[BUCKETS]{};
+  std::size_t _size{};
+  Key _last{};
+
+public:
+  RadixHeap() = default;
+
+  ~RadixHeap() { RADIX_HEAP_DEBUG_MS("RADIX_HEAP Dtor"); };
+
+  RadixHeap(const self& other) = default;
+  RadixHeap(self&& other) noexcept = default;
+
+  self& operator=(const self& other) {
+    self copy{other};
+    copy.swap(*this);
+    return *this;
+  };
+
+  self& operator=(self&& other) noexcept {
+    self move{std::move(other)};
+    move.swap(*this);
+    return *this;
+  };
+
+  void swap(self& other) noexcept {
+    using std::swap;
+    for (std::size_t i{}; i < BUCKETS; ++i) {
+      swap(_buckets[i], other._buckets[i]);
+    }
+    swap(_size, other._size);
+    swap(_last, other._last);
+  }
+
+  void friend swap(self& e1, self& e2) noexcept { e1.swap(e2); };
+
+  bool empty() const noexcept { return _size == 0; }
+  std::size_t size() const noexcept { return _size; }
+  // the last key popped, pushes must not go below it
+  Key last_key() const noexcept { return _last; }
+
+  void push(Key key, const Value& value) {
+    validateKey(key);
+    _buckets[bucket_index(key)].push_back(value_type{key, value});
+    ++_size;
+  }
+
+  void push(Key key, Value&& value) {
+    validateKey(key);
+    _buckets[bucket_index(key)].push_back(value_type{key, std::move(value)});
+    ++_size;
+  }
+
+  // an entry with the smallest key, the heap must not be empty
+  reference top() {
+    refill();
+    return _buckets[0].back();
+  }
+
+  // removes and returns top(), the heap must not be empty
+  value_type pop() {
+    refill();
+    --_size;
+    return _buckets[0].pop_back();
+  }
+
+  // keeps the buckets' storage and the last key
+  void clear() {
+    for (Vector<value_type>& bucket : _buckets) {
+      bucket.clear();
+    }
+    _size = 0;
+  }
+
+private:
+  std::size_t bucket_index(Key key) const noexcept {
+    return static_cast<std::size_t>(std::bit_width(key ^ _last));
+  }
+
+  void validateKey(Key key) const {
+    if (key < _last) {
+      throw std::invalid_argument("key is below the last popped key");
+    }
+  }
+
+  // makes sure bucket 0 holds the smallest key
+  void refill() {
+    if (!_buckets[0].empty()) {
+      return;
+    }
+    std::size_t index{1};
+    while (_buckets[index].empty()) {
+      ++index;
+    }
+    Vector<value_type>& bucket{_buckets[index]};
+    Key smallest{bucket[0].first};
+    for (value_type& entry : bucket) {
+      if (entry.first < smallest) {
+        smallest = entry.first;
+      }
+    }
+    // every entry agrees with the new last key on all bits above index, so
+    // it lands in a bucket below index
+    _last = smallest;
+    for (value_type& entry : bucket) {
+      _buckets[bucket_index(entry.first)].push_back(std::move(entry));
+    }
+    bucket.clear();
+  }
+};
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+// Link fields for IntrusiveList, inherited by the objects that go in it. An
+// object can sit in one list per Tag at a time:
+//
+//   struct ReadyTag {};
+//   struct Task : IntrusiveListHook<>, IntrusiveListHook<ReadyTag> {...};
+//   IntrusiveList<Task> all{};
+//   IntrusiveList<Task, ReadyTag> ready{};
+template <typename Tag = void> class IntrusiveListHook {
+  template <typename, typename> friend class IntrusiveList;
+
+private:
+  IntrusiveListHook* _next{nullptr};
+  IntrusiveListHook* _prev{nullptr};
+
+public:
+  IntrusiveListHook() = default;
+  ~IntrusiveListHook() { assert(!is_linked() && "destroyed while in a list"); }
+
+  // copies of an object start out of every list
+  IntrusiveListHook(const IntrusiveListHook&) {}
+  IntrusiveListHook& operator=(const IntrusiveListHook&) { return *this; }
+
+  bool is_linked() const { return _next != nullptr; }
+};
+
+// List whose nodes are the objects themselves. The list never allocates,
+// copies or destroys elements: push links the object passed in, erase and
+// pop unlink it and leave it to its owner. Moving an object between lists
+// (pop_front + push_back, splice) is a handful of pointer writes.
+// Objects must be unlinked before they are destroyed.
+template <typename T, typename Tag = void> class IntrusiveList {
+  using Hook = IntrusiveListHook<Tag>;
+
+public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using self = IntrusiveList<T, Tag>;
+
+private:
+  std::size_t _size{};
+  // _sentinal._next is head, _sentinal._prev is tail
+  Hook _sentinal{};
+
+  static T& element(Hook* hook) { return static_cast<T&>(*hook); }
+  static Hook* hook(T& element) { return static_cast<Hook*>(&element); }
+
+  static void link_before(Hook* hook, Hook* pos) noexcept {
+    hook->_next = pos;
+    hook->_prev = pos->_prev;
+    pos->_prev->_next = hook;
+    pos->_prev = hook;
+  }
+
+  static void unlink(Hook* hook) noexcept {
+    hook->_prev->_next = hook->_next;
+    hook->_next->_prev = hook->_prev;
+    hook->_next = nullptr;
+    hook->_prev = nullptr;
+  }
+
+  // move [first, last) in front of pos, pos must not be inside the range
+  static void transfer(Hook* pos, Hook* first, Hook* last) noexcept {
+    if (first == last || pos == first) {
+      return;
+    }
+    Hook* tail{last->_prev};
+    first->_prev->_next = last;
+    last->_prev = first->_prev;
+
+    first->_prev = pos->_prev;
+    tail->_next = pos;
+    pos->_prev->_next = first;
+    pos->_prev = tail;
+  }
+
+public:
+  class Iterator {
+    friend class IntrusiveList<T, Tag>;
+
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = T*;
+    using reference = T&;
+
+  private:
+    Hook* _current{nullptr};
+    Iterator(Hook* p) : _current{p} {}
+
+  public:
+    Iterator() = default;
+
+    reference operator*() const { return element(_current); }
+    pointer operator->() const { return &element(_current); }
+
+    Iterator& operator++() {
+      _current = _current->_next;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator tmp{*this};
+      ++(*this);
+      return tmp;
+    }
+    Iterator& operator--() {
+      _current = _current->_prev;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator tmp{*this};
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const Iterator& other) const = default;
+  };
+
+  using iterator = Iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  /* Constructors */
+  IntrusiveList() { _sentinal._next = _sentinal._prev = &_sentinal; }
+
+  // the objects stay where they are, they are only unlinked
+  ~IntrusiveList() {
+    clear();
+    _sentinal._next = _sentinal._prev = nullptr;
+  }
+
+  IntrusiveList(const self&) = delete;
+  self& operator=(const self&) = delete;
+
+  IntrusiveList(self&& move) noexcept : IntrusiveList() { splice(end(), move); }
+
+  self& operator=(self&& move) noexcept {
+    if (&move != this) {
+      clear();
+      splice(end(), move);
+    }
+    return *this;
+  }
+
+  /* Element access */
+  T& front() { return element(_sentinal._next); }
+  const T& front() const { return element(_sentinal._next); }
+  T& back() { return element(_sentinal._prev); }
+  const T& back() const { return element(_sentinal._prev); }
+
+  /* Iterators */
+  iterator begin() const { return iterator{_sentinal._next}; }
+  iterator end() const { return iterator{const_cast<Hook*>(&_sentinal)}; }
+  reverse_iterator rbegin() const { return reverse_iterator{end()}; }
+  reverse_iterator rend() const { return reverse_iterator{begin()}; }
+
+  // iterator to an object known to be in this list
+  iterator iterator_to(T& object) const { return iterator{hook(object)}; }
+
+  /* Capacity */
+  std::size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  /* Modifiers */
+  void push_back(T& object) { insert(end(), object); }
+  void push_front(T& object) { insert(begin(), object); }
+
+  void pop_back() { erase(iterator{_sentinal._prev}); }
+  void pop_front() { erase(iterator{_sentinal._next}); }
+
+  iterator insert(iterator pos, T& object) {
+    assert(!hook(object)->is_linked() && "already in a list");
+    link_before(hook(object), pos._current);
+    ++_size;
+    return iterator{hook(object)};
+  }
+
+  // unlinks pos, returns the iterator after it
+  iterator erase(iterator pos) {
+    Hook* next{pos._current->_next};
+    unlink(pos._current);
+    --_size;
+    return iterator{next};
+  }
+
+  iterator erase(iterator first, iterator last) {
+    while (first != last) {
+      first = erase(first);
+    }
+    return last;
+  }
+
+  // unlinks an object known to be in this list
+  void remove(T& object) { erase(iterator_to(object)); }
+
+  void clear() noexcept {
+    Hook* next{};
+    for (Hook* i{_sentinal._next}; i != &_sentinal; i = next) {
+      next = i->_next;
+      i->_next = i->_prev = nullptr;
+    }
+    _sentinal._next = _sentinal._prev = &_sentinal;
+    _size = 0;
+  }
+
+  // splice moves objects from other in front of pos. The whole list and
+  // single object versions are O(1); the range version counts the range
+  // unless count is given.
+  void splice(iterator pos, self& other) {
+    if (&other == this) {
+      return;
+    }
+    _size += std::exchange(other._size, 0);
+    transfer(pos._current, other._sentinal._next, &other._sentinal);
+  }
+
+  void splice(iterator pos, self& other, iterator object) {
+    if (pos == object || pos._current == object._current->_next) {
+      return;
+    }
+    --other._size;
+    ++_size;
+    transfer(pos._current, object._current, object._current->_next);
+  }
+
+  void splice(iterator pos, self& other, iterator first, iterator last) {
+    std::size_t count{&other == this ? 0
+                                     : static_cast<std::size_t>(
+                                           std::distance(first, last))};
+    splice(pos, other, first, last, count);
+  }
+
+  void splice(iterator pos, self& other, iterator first, iterator last,
+              std::size_t count) {
+    if (&other != this) {
+      other._size -= count;
+      _size += count;
+    }
+    transfer(pos._current, first._current, last._current);
+  }
+
+  void swap(self& other) noexcept {
+    self temp{};
+    temp.splice(temp.end(), other);
+    other.splice(other.end(), *this);
+    splice(end(), temp);
+  }
+  friend void swap(self& a, self& b) noexcept { a.swap(b); }
+};
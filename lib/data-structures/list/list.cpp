@@ -41,10 +41,62 @@ template <typename T> void List<T>::unlink_node(Node& node) {
 
 template <typename T> void List<T>::remove_node(Node* node) {
   unlink_node(*node);
-  delete node;
+  destroy_node(node);
   --_size;
 };
 
+template <typename T>
+template <typename U>
+typename List<T>::DataNode* List<T>::create_node(U&& data) {
+  void* memory{};
+  if (_free) {
+    memory = std::exchange(_free, _free->_next);
+    --_freeCount;
+  } else {
+    memory = ::operator new(sizeof(DataNode));
+  }
+  try {
+    return new (memory) DataNode{std::forward<U>(data)};
+  } catch (...) {
+    _free = new (memory) FreeNode{_free};
+    ++_freeCount;
+    throw;
+  }
+}
+
+template <typename T> void List<T>::destroy_node(Node* node) noexcept {
+  DataNode* dataNode{static_cast<DataNode*>(node)};
+  dataNode->~DataNode();
+  if (_freeCount == MAX_FREE_NODES) {
+    ::operator delete(static_cast<void*>(dataNode));
+    return;
+  }
+  _free = new (static_cast<void*>(dataNode)) FreeNode{_free};
+  ++_freeCount;
+}
+
+template <typename T> void List<T>::release_free_nodes() noexcept {
+  while (_free) {
+    ::operator delete(std::exchange(_free, _free->_next));
+  }
+  _freeCount = 0;
+}
+
+template <typename T>
+void List<T>::transfer(Node* pos, Node* first, Node* last) noexcept {
+  if (first == last || pos == first) {
+    return;
+  }
+  Node* tail{last->_prev};
+  first->_prev->_next = last;
+  last->_prev = first->_prev;
+
+  first->_prev = pos->_prev;
+  tail->_next = pos;
+  pos->_prev->_next = first;
+  pos->_prev = tail;
+}
+
 template <typename T>
 typename List<T>::Node* List<T>::reverse_recursive_foward(Node* node) noexcept {
   if (node->_next == end()._current) {
@@ -68,10 +120,10 @@ List<T>::List(std::size_t capacity, T defaultValue)
   if (capacity <= 0) {
     throw OutOfRangeException("capacity should be greater than 0");
   }
-  DataNode* temp{new DataNode{defaultValue}};
+  DataNode* temp{create_node(defaultValue)};
   link_node_right(*temp, _sentinal);
   for (std::size_t i{0}; i < _size - 1; ++i) {
-    DataNode* newNode{new DataNode{defaultValue}};
+    DataNode* newNode{create_node(defaultValue)};
     link_node_right(*newNode, *temp);
     temp = newNode;
   }
@@ -94,8 +146,9 @@ template <typename T> List<T>::~List() {
   Node* next;
   for (Node* i = _sentinal._next; i != &_sentinal; i = next) {
     next = i->_next;
-    delete i;
+    destroy_node(i);
   }
+  release_free_nodes();
 };
 
 template <typename T>
@@ -302,7 +355,7 @@ template <typename T> void List<T>::pop_front() {
 
 template <typename T>
 typename List<T>::iterator List<T>::insert(iterator pos, const T& element) {
-  DataNode* newNode{new DataNode{element}};
+  DataNode* newNode{create_node(element)};
   link_node_left(*newNode, *pos._current);
   ++_size;
   return iterator{newNode};
@@ -310,7 +363,7 @@ typename List<T>::iterator List<T>::insert(iterator pos, const T& element) {
 
 template <typename T>
 typename List<T>::iterator List<T>::insert(iterator pos, T&& element) {
-  DataNode* newNode{new DataNode{std::move(element)}};
+  DataNode* newNode{create_node(std::move(element))};
   link_node_left(*newNode, *pos._current);
   ++_size;
   return iterator{newNode};
@@ -322,7 +375,7 @@ typename List<T>::iterator List<T>::insert(iterator pos, InputIterator begin,
                                            InputIterator end) {
   iterator previousIter{--pos};
   for (auto i{begin}; i != end; ++i) {
-    DataNode* newNode{new DataNode{*i}};
+    DataNode* newNode{create_node(*i)};
     link_node_right(*newNode, *previousIter._current);
     ++_size;
     previousIter = iterator{newNode};
@@ -348,6 +401,43 @@ typename List<T>::iterator List<T>::erase(iterator first, iterator last) {
   return last;
 }
 
+template <typename T> void List<T>::splice(iterator pos, List<T>& other) {
+  if (&other == this) {
+    return;
+  }
+  _size += std::exchange(other._size, 0);
+  transfer(pos._current, other._sentinal._next, &other._sentinal);
+}
+
+template <typename T>
+void List<T>::splice(iterator pos, List<T>& other, iterator node) {
+  if (pos == node || pos._current == node._current->_next) {
+    return;
+  }
+  --other._size;
+  ++_size;
+  transfer(pos._current, node._current, node._current->_next);
+}
+
+template <typename T>
+void List<T>::splice(iterator pos, List<T>& other, iterator first,
+                     iterator last) {
+  std::size_t count{&other == this ? 0
+                                   : static_cast<std::size_t>(
+                                         std::distance(first, last))};
+  splice(pos, other, first, last, count);
+}
+
+template <typename T>
+void List<T>::splice(iterator pos, List<T>& other, iterator first,
+                     iterator last, std::size_t count) {
+  if (&other != this) {
+    other._size -= count;
+    _size += count;
+  }
+  transfer(pos._current, first._current, last._current);
+}
+
 template <typename T> void List<T>::reverse_iter() noexcept {
   Node* previous{&_sentinal};
   for (Node* ptr{_sentinal._next}; ptr != end()._current;) {
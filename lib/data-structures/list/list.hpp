@@ -8,6 +8,8 @@
 #include <utility>
 
 template <typename T> class List {
+  // recycled nodes kept at most, erasing beyond that frees the node
+  inline static constexpr std::size_t MAX_FREE_NODES{64};
 
   class OutOfRangeException : public std::exception {
   private:
@@ -50,10 +52,26 @@ private:
     DataNode(T&& data) : Node(), _data{std::move(data)} {};
   };
 
+  // what a recycled DataNode holds while it waits in the free list
+  struct FreeNode {
+    FreeNode* _next{nullptr};
+  };
+
 private:
   std::size_t _size{};
   // _sentinal._next is head, _sentinal._prev is tail
   Node _sentinal{};
+  // memory of unlinked DataNodes, reused by the next insert instead of
+  // going back to new/delete. Up to MAX_FREE_NODES are kept, released by
+  // shrink_to_fit or the destructor
+  FreeNode* _free{nullptr};
+  std::size_t _freeCount{};
+
+  template <typename U> DataNode* create_node(U&& data);
+  void destroy_node(Node* node) noexcept;
+  void release_free_nodes() noexcept;
+  // move [first, last) in front of pos, pos must not be inside the range
+  static void transfer(Node* pos, Node* first, Node* last) noexcept;
 
   void link_node_right(Node& newNode, Node& nodeToLinkTo);
   void link_node_left(Node& newNode, Node& nodeToLinkTo);
@@ -149,6 +167,8 @@ public:
     swap(_sentinal._prev, copy._sentinal._prev);
 
     swap(_size, copy._size);
+    swap(_free, copy._free);
+    swap(_freeCount, copy._freeCount);
   }
   friend void swap(List<T>& a, List<T>& b) noexcept { a.swap(b); };
 
@@ -171,6 +191,20 @@ public:
   iterator erase(iterator pos);
   iterator erase(iterator first, iterator last);
 
+  // splice moves nodes from other in front of pos without copying or
+  // allocating. The whole list and single node versions are O(1); the range
+  // version counts the range unless count is given.
+  void splice(iterator pos, List<T>& other);
+  void splice(iterator pos, List<T>& other, iterator node);
+  void splice(iterator pos, List<T>& other, iterator first, iterator last);
+  void splice(iterator pos, List<T>& other, iterator first, iterator last,
+              std::size_t count);
+
+  // give the memory of recycled nodes back
+  void shrink_to_fit() noexcept { release_free_nodes(); }
+  // nodes waiting to be reused, at most MAX_FREE_NODES
+  std::size_t free_nodes() const noexcept { return _freeCount; }
+
   void reverse_iter() noexcept;
   void reverse_recursive() noexcept;
 };
@@ -0,0 +1,510 @@
+#pragma once
+
+#include <algorithm>
+#include <allocator.hpp>
+#include <concept.hpp>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+inline constexpr std::size_t DEFAULT_UNROLLED_LIST_BLOCK_SIZE{512};
+
+// Doubly linked list of blocks, each holding up to BlockSize elements in a
+// plain array. Traversal touches one node per block instead of one per
+// element, and indexed access skips whole blocks, so long lists stay cache
+// friendly. Same interface as List.
+// Inserting into a full block splits it in half, erasing merges a block that
+// drops below half full with its neighbour when they fit together. Inserts
+// and erases shift at most one block, splice relinks blocks in O(1).
+// Like Vector, inserts and erases invalidate iterators into the block they
+// touch (and the one after it, on a split or merge).
+template <typename T,
+          std::size_t BlockSize = std::max<std::size_t>(
+              8, DEFAULT_UNROLLED_LIST_BLOCK_SIZE / sizeof(T)),
+          concepts::Allocator Allocator = Allocator<T>>
+class UnrolledList {
+  static_assert(BlockSize > 1, "use List for one element per node");
+
+  inline static constexpr bool isTriviallyRelocatable{
+      std::is_trivially_move_constructible_v<T> &&
+      std::is_trivially_destructible_v<T>};
+
+public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using rvalue_reference = T&&;
+  using pointer = T*;
+  using self = UnrolledList<T, BlockSize, Allocator>;
+
+  class OutOfRangeException : public std::exception {
+    using std::exception::what;
+
+  private:
+    std::string message;
+
+  public:
+    OutOfRangeException(std::string msg) : message{msg} {}
+    std::string what() { return message; }
+  };
+
+private:
+  // the sentinal is a Link with no elements, _sentinal._next is the head
+  // block, _sentinal._prev the tail block
+  struct Link {
+    Link* _next{this};
+    Link* _prev{this};
+    std::size_t _count{};
+  };
+
+  struct Block : public Link {
+    alignas(T) std::byte _storage[BlockSize * sizeof(T)];
+
+    T* elements() noexcept { return reinterpret_cast<T*>(_storage); }
+  };
+
+  using BlockAllocator = typename Allocator::template rebind<Block>::other;
+
+  BlockAllocator _allocator{};
+  std::size_t _size{};
+  Link _sentinal{};
+
+  static Block* asBlock(Link* link) noexcept {
+    return static_cast<Block*>(link);
+  }
+
+  // new empty block linked in front of next
+  Block* createBlock(Link& next) {
+    Block* block{::new (_allocator.allocate(1)) Block};
+    block->_next = &next;
+    block->_prev = next._prev;
+    next._prev->_next = block;
+    next._prev = block;
+    return block;
+  }
+
+  void destroyBlock(Block* block) noexcept {
+    std::destroy_n(block->elements(), block->_count);
+    block->_prev->_next = block->_next;
+    block->_next->_prev = block->_prev;
+    block->~Block();
+    _allocator.deallocate(block, 1);
+  }
+
+  // move from[start, from count) to the end of to
+  static void relocateTail(Block* from, std::size_t start, Block* to) {
+    std::size_t count{from->_count - start};
+    T* source{from->elements() + start};
+    T* dest{to->elements() + to->_count};
+    if constexpr (isTriviallyRelocatable) {
+      std::memcpy(static_cast<void*>(dest), source, count * sizeof(T));
+    } else {
+      for (std::size_t i{}; i < count; ++i) {
+        new (dest + i) T{std::move(source[i])};
+        source[i].~T();
+      }
+    }
+    from->_count = start;
+    to->_count += count;
+  }
+
+  // open an unconstructed gap at index, block must not be full
+  static void shiftRight(Block* block, std::size_t index) {
+    T* elements{block->elements()};
+    if constexpr (isTriviallyRelocatable) {
+      std::memmove(static_cast<void*>(elements + index + 1), elements + index,
+                   (block->_count - index) * sizeof(T));
+    } else {
+      for (std::size_t i{block->_count}; i > index; --i) {
+        new (elements + i) T{std::move(elements[i - 1])};
+        elements[i - 1].~T();
+      }
+    }
+  }
+
+  // close the gap left by the already destroyed element at index
+  static void shiftLeft(Block* block, std::size_t index) {
+    T* elements{block->elements()};
+    if constexpr (isTriviallyRelocatable) {
+      std::memmove(static_cast<void*>(elements + index), elements + index + 1,
+                   (block->_count - index - 1) * sizeof(T));
+    } else {
+      for (std::size_t i{index + 1}; i < block->_count; ++i) {
+        new (elements + i - 1) T{std::move(elements[i])};
+        elements[i].~T();
+      }
+    }
+  }
+
+  // pull the next block into this one once this one is under half full
+  void mergeNext(Block* block) {
+    Link* next{block->_next};
+    if (next != &_sentinal && block->_count < BlockSize / 2 &&
+        block->_count + next->_count <= BlockSize) {
+      relocateTail(asBlock(next), 0, block);
+      destroyBlock(asBlock(next));
+    }
+  }
+
+  // make block end right before index, returns the block holding the rest
+  Block* splitAt(Block* block, std::size_t index) {
+    Block* upper{createBlock(*block->_next)};
+    relocateTail(block, index, upper);
+    return upper;
+  }
+
+  // move the chain of blocks of from to to, to must be empty
+  static void relink(Link& to, Link& from) noexcept {
+    if (from._next == &from) {
+      to._next = to._prev = &to;
+      return;
+    }
+    to._next = from._next;
+    to._prev = from._prev;
+    to._next->_prev = &to;
+    to._prev->_next = &to;
+    from._next = from._prev = &from;
+  }
+
+  template <typename U> class BasicIterator;
+
+  BasicIterator<T> iteratorAt(std::size_t index) const {
+    Link* link{};
+    if (index < _size / 2) {
+      link = _sentinal._next;
+      while (index >= link->_count) {
+        index -= link->_count;
+        link = link->_next;
+      }
+    } else {
+      // walk back from the tail, index counts from the end
+      index = _size - index;
+      link = _sentinal._prev;
+      while (index > link->_count) {
+        index -= link->_count;
+        link = link->_prev;
+      }
+      index = link->_count - index;
+    }
+    return {link, index};
+  }
+
+  void validateIndex(std::size_t index) const {
+    if (index >= _size) {
+      throw OutOfRangeException{"Index out of range"};
+    }
+  }
+
+public:
+  using Iterator = BasicIterator<T>;
+  using ConstIterator = BasicIterator<const T>;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /* Constructors */
+  UnrolledList() = default;
+
+  UnrolledList(std::size_t count, const T& defaultValue = T()) {
+    for (std::size_t i{}; i < count; ++i) {
+      push_back(defaultValue);
+    }
+  }
+
+  template <std::input_iterator InputIterator>
+  UnrolledList(InputIterator first, InputIterator last) {
+    insert(end(), first, last);
+  }
+
+  UnrolledList(std::initializer_list<T> list)
+      : UnrolledList(list.begin(), list.end()) {}
+
+  ~UnrolledList() { clear(); }
+
+  UnrolledList(const self& copy) : UnrolledList(copy.begin(), copy.end()) {}
+
+  self& operator=(const self& copy) {
+    self tempCopy{copy};
+    swap(tempCopy);
+    return *this;
+  }
+
+  UnrolledList(self&& move) noexcept
+      : _allocator{std::move(move._allocator)},
+        _size{std::exchange(move._size, 0)} {
+    relink(_sentinal, move._sentinal);
+  }
+
+  self& operator=(self&& move) noexcept {
+    self tempMove{std::move(move)};
+    swap(tempMove);
+    return *this;
+  }
+
+  /* Element access */
+  T& operator[](std::size_t index) { return *iteratorAt(index); }
+  const T& operator[](std::size_t index) const { return *iteratorAt(index); }
+
+  T& at(std::size_t index) {
+    validateIndex(index);
+    return *iteratorAt(index);
+  }
+  const T& at(std::size_t index) const {
+    validateIndex(index);
+    return *iteratorAt(index);
+  }
+
+  T& front() { return asBlock(_sentinal._next)->elements()[0]; }
+  const T& front() const { return asBlock(_sentinal._next)->elements()[0]; }
+
+  T& back() {
+    return asBlock(_sentinal._prev)->elements()[_sentinal._prev->_count - 1];
+  }
+  const T& back() const {
+    return asBlock(_sentinal._prev)->elements()[_sentinal._prev->_count - 1];
+  }
+
+  /* Iterators */
+  iterator begin() { return {_sentinal._next, 0}; }
+  iterator end() { return {&_sentinal, 0}; }
+  const_iterator begin() const { return {_sentinal._next, 0}; }
+  const_iterator end() const { return {const_cast<Link*>(&_sentinal), 0}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  reverse_iterator rbegin() { return reverse_iterator{end()}; }
+  reverse_iterator rend() { return reverse_iterator{begin()}; }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator{end()};
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator{begin()};
+  }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  const_reverse_iterator crend() const { return rend(); }
+
+  /* Capacity */
+  std::size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+  static constexpr std::size_t block_size() { return BlockSize; }
+
+  /* Modifiers */
+  void clear() noexcept {
+    while (_sentinal._next != &_sentinal) {
+      destroyBlock(asBlock(_sentinal._next));
+    }
+    _size = 0;
+  }
+
+  void push_back(const T& element) { emplace(end(), element); }
+  void push_back(T&& element) { emplace(end(), std::move(element)); }
+  void push_front(const T& element) { emplace(begin(), element); }
+  void push_front(T&& element) { emplace(begin(), std::move(element)); }
+
+  template <typename... Args> T& emplace_back(Args&&... args) {
+    return *emplace(end(), std::forward<Args>(args)...);
+  }
+
+  template <typename... Args> T& emplace_front(Args&&... args) {
+    return *emplace(begin(), std::forward<Args>(args)...);
+  }
+
+  void pop_back() { erase(--end()); }
+  void pop_front() { erase(begin()); }
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    // built first, args may refer to an element that is about to move
+    T value{std::forward<Args>(args)...};
+    Link* link{pos._block};
+    std::size_t index{pos._index};
+    if (index == 0 && link->_prev != &_sentinal &&
+        link->_prev->_count < BlockSize) {
+      // the end of the previous block is the same position and needs no shift
+      link = link->_prev;
+      index = link->_count;
+    } else if (link == &_sentinal ||
+               (index == 0 && link->_count == BlockSize)) {
+      link = createBlock(*link);
+    } else if (link->_count == BlockSize) {
+      Block* upper{splitAt(asBlock(link), BlockSize / 2)};
+      if (index > BlockSize / 2) {
+        link = upper;
+        index -= BlockSize / 2;
+      }
+    }
+    Block* block{asBlock(link)};
+    shiftRight(block, index);
+    new (block->elements() + index) T{std::move(value)};
+    ++block->_count;
+    ++_size;
+    return {block, index};
+  }
+
+  iterator insert(const_iterator pos, const T& element) {
+    return emplace(pos, element);
+  }
+  iterator insert(const_iterator pos, T&& element) {
+    return emplace(pos, std::move(element));
+  }
+
+  // returns an iterator to the first inserted element, or pos if none
+  template <std::input_iterator InputIterator>
+  iterator insert(const_iterator pos, InputIterator first,
+                  InputIterator last) {
+    if (first == last) {
+      return {pos._block, pos._index};
+    }
+    iterator inserted{emplace(pos, *first)};
+    iterator next{inserted};
+    for (++first; first != last; ++first) {
+      next = emplace(++next, *first);
+      // splitting the block of the first element moves its upper half to
+      // the block after it
+      if (inserted._index >= inserted._block->_count) {
+        inserted = {inserted._block->_next,
+                    inserted._index - inserted._block->_count};
+      }
+    }
+    return inserted;
+  }
+
+  iterator erase(const_iterator pos) {
+    Block* block{asBlock(pos._block)};
+    std::size_t index{pos._index};
+    block->elements()[index].~T();
+    shiftLeft(block, index);
+    --block->_count;
+    --_size;
+    if (block->_count == 0) {
+      Link* next{block->_next};
+      destroyBlock(block);
+      return {next, 0};
+    }
+    mergeNext(block);
+    if (index == block->_count) {
+      return {block->_next, 0};
+    }
+    return {block, index};
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    // a merge can move the elements last points to, count them instead
+    auto count{std::distance(first, last)};
+    iterator pos{first._block, first._index};
+    for (; count > 0; --count) {
+      pos = erase(pos);
+    }
+    return pos;
+  }
+
+  // moves every element of other in front of pos. Whole blocks are relinked,
+  // only the block pos points into is split. Allocators must be
+  // interchangeable, as for every node container here.
+  void splice(const_iterator pos, self& other) {
+    if (&other == this || other.empty()) {
+      return;
+    }
+    Link* next{pos._block};
+    if (pos._index != 0) {
+      next = splitAt(asBlock(next), pos._index);
+    }
+    Link* first{other._sentinal._next};
+    Link* last{other._sentinal._prev};
+    first->_prev = next->_prev;
+    last->_next = next;
+    next->_prev->_next = first;
+    next->_prev = last;
+    other._sentinal._next = other._sentinal._prev = &other._sentinal;
+    _size += std::exchange(other._size, 0);
+  }
+
+  void splice(const_iterator pos, self&& other) { splice(pos, other); }
+
+  void swap(self& other) noexcept {
+    using std::swap;
+    Link temp{};
+    relink(temp, _sentinal);
+    relink(_sentinal, other._sentinal);
+    relink(other._sentinal, temp);
+    swap(_size, other._size);
+    swap(_allocator, other._allocator);
+  }
+  friend void swap(self& a, self& b) noexcept { a.swap(b); }
+};
+
+template <typename T, std::size_t BlockSize, concepts::Allocator Allocator>
+template <typename U>
+class UnrolledList<T, BlockSize, Allocator>::BasicIterator {
+  friend class UnrolledList<T, BlockSize, Allocator>;
+  template <typename> friend class BasicIterator;
+
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using pointer = U*;
+  using reference = U&;
+
+private:
+  Link* _block{nullptr};
+  std::size_t _index{};
+
+  BasicIterator(Link* block, std::size_t index)
+      : _block{block}, _index{index} {}
+
+public:
+  BasicIterator() = default;
+
+  // iterator -> const_iterator
+  operator BasicIterator<const U>() const
+    requires(!std::is_const_v<U>)
+  {
+    return {_block, _index};
+  }
+
+  reference operator*() const {
+    return static_cast<Block*>(_block)->elements()[_index];
+  }
+  pointer operator->() const {
+    return static_cast<Block*>(_block)->elements() + _index;
+  }
+
+  BasicIterator& operator++() {
+    if (++_index == _block->_count) {
+      _block = _block->_next;
+      _index = 0;
+    }
+    return *this;
+  }
+
+  BasicIterator operator++(int) {
+    BasicIterator tmp{*this};
+    ++(*this);
+    return tmp;
+  }
+
+  BasicIterator& operator--() {
+    if (_index == 0) {
+      _block = _block->_prev;
+      _index = _block->_count;
+    }
+    --_index;
+    return *this;
+  }
+
+  BasicIterator operator--(int) {
+    BasicIterator tmp{*this};
+    --(*this);
+    return tmp;
+  }
+
+  bool operator==(const BasicIterator& other) const = default;
+};
@@ -3,8 +3,10 @@
 #include <cmath>
 #include <concept.hpp>
 #include <cstddef>
+#include <dary-heap.hpp>
 #include <heap.hpp>
 #include <helpers.hpp>
+#include <indexed-heap.hpp>
 #include <initializer_list>
 #include <iterator>
 #include <string>
@@ -23,11 +25,15 @@
   } while (0)
 #endif
 
-template <typename T, typename Comparator = std::less_equal<T>>
+// Container is the heap underneath, Heap or a DaryHeap with the same
+// Comparator; see DaryPriorityQueue. With an IndexedHeap the elements are
+// ids with a priority each, see IndexedPriorityQueue.
+template <typename T, typename Comparator = std::less_equal<T>,
+          typename Container = Heap<T, Comparator>>
 class PriorityQueue {
 
 private:
-  Heap<T, Comparator> _container{};
+  Container _container{};
 
 public:
   using value_type = T;
@@ -35,7 +41,7 @@ public:
   using reference = value_type&;
   using rvalue_reference = value_type&&;
   using const_reference = const value_type&;
-  using self = PriorityQueue<T, Comparator>;
+  using self = PriorityQueue<T, Comparator, Container>;
 
   PriorityQueue() = default;
 
@@ -82,11 +88,36 @@ public:
 
   bool empty() const noexcept { return _container.empty(); }
 
-  reference top() noexcept { return _container.top(); }
+  // the element on top, the top id with an IndexedHeap
+  decltype(auto) top() noexcept { return _container.top(); }
 
   void push(const_reference data) { _container.push(data); }
 
   void push(rvalue_reference data) { _container.push(std::move(data)); }
 
-  value_type pop() { return _container.pop(); }
-};
\ No newline at end of file
+  // the element, or an IndexedHeap's id and priority
+  decltype(auto) pop() { return _container.pop(); }
+
+  /* IndexedHeap only */
+  void push(std::size_t id, const_reference priority) {
+    _container.push(id, priority);
+  }
+  void update(std::size_t id, const_reference priority) {
+    _container.update(id, priority);
+  }
+  void erase(std::size_t id) { _container.erase(id); }
+  bool contains(std::size_t id) const { return _container.contains(id); }
+};
+
+// for large queues, where the binary heap's pops miss the cache on every
+// level
+template <typename T, std::size_t Arity = 4,
+          typename Comparator = std::less_equal<T>>
+using DaryPriorityQueue =
+    PriorityQueue<T, Comparator, DaryHeap<T, Arity, Comparator>>;
+
+// elements are dense ids whose priority can change in place: timers that
+// get rescheduled, vertices relaxed by a shortest path search
+template <typename Priority, typename Comparator = std::less_equal<Priority>>
+using IndexedPriorityQueue =
+    PriorityQueue<Priority, Comparator, IndexedHeap<Priority, Comparator>>;
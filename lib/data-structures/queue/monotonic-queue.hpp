@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstddef>
+#include <deque.hpp>
+#include <functional>
+#include <optional>
+#include <utility>
+
+// FIFO window that knows its minimum in O(1), the queue counterpart of
+// MinStack. Next to the elements it keeps the candidates: the elements that
+// can still become the minimum, i.e. those with nothing smaller after them.
+// They are sorted, so the minimum is the first one. A push drops the
+// candidates it beats from the back, a pop drops the first candidate if it
+// was the popped element. Each element enters and leaves the candidates
+// once, so push and pop are amortised O(1).
+// Comparator picks what "minimum" means: std::greater<T> gives the maximum.
+// With a window the oldest element is popped on its own once a push makes
+// the queue longer than it.
+// Container is the storage of both, anything with push_back, pop_back,
+// pop_front, front and back. For many small windows a StaticCircularBuffer
+// of the window size, or a Deque with smaller blocks, keeps each queue
+// small:
+//
+//   using Samples = StaticCircularBuffer<double, 60>;
+//   MonotonicQueue<double, std::less<double>, Samples> lastMinute{60};
+template <typename T, typename Comparator = std::less<T>,
+          typename Container = Deque<T>>
+class MonotonicQueue {
+public:
+  using value_type = T;
+  using reference = T&;
+  using rvalue_reference = T&&;
+  using const_reference = const T&;
+  using self = MonotonicQueue<T, Comparator, Container>;
+
+private:
+  Container _elements{};
+  Container _candidates{};
+  std::size_t _window{};
+  Comparator _compare{};
+
+public:
+  // window 0 keeps every element until it is popped
+  explicit MonotonicQueue(std::size_t window = 0, Comparator compare = {})
+      : _window{window}, _compare{std::move(compare)} {}
+
+  /* Element access */
+  // the minimum per Comparator
+  const_reference min() const { return _candidates.front(); }
+  const_reference front() const { return _elements.front(); }
+  const_reference back() const { return _elements.back(); }
+
+  /* Capacity */
+  bool empty() const noexcept { return _elements.empty(); }
+  std::size_t size() const noexcept { return _elements.size(); }
+  std::size_t window() const noexcept { return _window; }
+
+  /* Modifiers */
+  void push(const_reference value) {
+    if (_window && size() == _window) {
+      pop();
+    }
+    // equal candidates stay, each leaves with its own element
+    while (!_candidates.empty() && _compare(value, _candidates.back())) {
+      _candidates.pop_back();
+    }
+    _candidates.push_back(value);
+    _elements.push_back(value);
+  }
+
+  // removes the oldest element and returns it
+  value_type pop() {
+    value_type oldest{_elements.pop_front()};
+    if (!_compare(_candidates.front(), oldest)) {
+      _candidates.pop_front();
+    }
+    return oldest;
+  }
+
+  void swap(self& other) noexcept {
+    using std::swap;
+    swap(_elements, other._elements);
+    swap(_candidates, other._candidates);
+    swap(_window, other._window);
+    swap(_compare, other._compare);
+  }
+  friend void swap(self& a, self& b) noexcept { a.swap(b); }
+};
+
+// FIFO window that folds its elements with any associative Operation (sum,
+// max, gcd, string concatenation...) in O(1), where MonotonicQueue only
+// handles min and max.
+// Two stacks: pushes go on the back one, which keeps the running fold of
+// everything on it. Pops take from the front one, where every entry holds
+// the fold from itself to the newest entry of that stack; when it runs dry
+// the back stack is poured into it, oldest on top. Every element is moved
+// once, so all operations are amortised O(1). The fold of the window is
+// op(front fold, back fold), in that order, so Operation does not have to
+// be commutative, nor have an identity.
+//
+//   AggregateQueue<long, std::plus<long>> lastHour{3600};
+template <typename T, typename Operation> class AggregateQueue {
+public:
+  using value_type = T;
+  using reference = T&;
+  using rvalue_reference = T&&;
+  using const_reference = const T&;
+  using self = AggregateQueue<T, Operation>;
+
+private:
+  struct Entry {
+    T _value;
+    // _value folded with everything newer on the front stack
+    T _aggregate;
+  };
+
+  // top (back()) is the oldest element
+  Deque<Entry> _front{};
+  Deque<T> _back{};
+  std::optional<T> _backAggregate{};
+  std::size_t _window{};
+  Operation _operation{};
+
+  void pour() {
+    while (!_back.empty()) {
+      T value{_back.pop_back()};
+      T aggregate{_front.empty() ? value
+                                 : _operation(value, _front.back()._aggregate)};
+      _front.push_back(Entry{std::move(value), std::move(aggregate)});
+    }
+    _backAggregate.reset();
+  }
+
+public:
+  // window 0 keeps every element until it is popped
+  explicit AggregateQueue(std::size_t window = 0, Operation operation = {})
+      : _window{window}, _operation{std::move(operation)} {}
+
+  /* Element access */
+  // every element folded, oldest first. The queue must not be empty.
+  value_type aggregate() const {
+    if (_front.empty()) {
+      return *_backAggregate;
+    }
+    if (!_backAggregate) {
+      return _front.back()._aggregate;
+    }
+    return _operation(_front.back()._aggregate, *_backAggregate);
+  }
+
+  const_reference front() const {
+    return _front.empty() ? _back.front() : _front.back()._value;
+  }
+  const_reference back() const {
+    return _back.empty() ? _front.front()._value : _back.back();
+  }
+
+  /* Capacity */
+  bool empty() const noexcept { return size() == 0; }
+  std::size_t size() const noexcept { return _front.size() + _back.size(); }
+  std::size_t window() const noexcept { return _window; }
+
+  /* Modifiers */
+  void push(const_reference value) {
+    if (_window && size() == _window) {
+      pop();
+    }
+    if (_backAggregate) {
+      _backAggregate = _operation(*_backAggregate, value);
+    } else {
+      _backAggregate = value;
+    }
+    _back.push_back(value);
+  }
+
+  // removes the oldest element and returns it
+  value_type pop() {
+    if (_front.empty()) {
+      pour();
+    }
+    return _front.pop_back()._value;
+  }
+
+  void swap(self& other) noexcept {
+    using std::swap;
+    swap(_front, other._front);
+    swap(_back, other._back);
+    swap(_backAggregate, other._backAggregate);
+    swap(_window, other._window);
+    swap(_operation, other._operation);
+  }
+  friend void swap(self& a, self& b) noexcept { a.swap(b); }
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <allocator.hpp>
 #include <cmath>
 #include <concept.hpp>
@@ -23,6 +24,12 @@
   } while (0)
 #endif
 
+// FIFO over a ring buffer: push_back writes after the tail and wraps around
+// to the start of the allocation, pop_front advances the head, so neither
+// moves the other elements. The storage only grows (and is straightened
+// out) once every slot is taken.
+// Because the elements wrap around they are not contiguous, index through
+// operator[] or the iterators.
 template <typename T, typename Allocator = Allocator<T>> class Queue {
   inline static constexpr double growRate{2};
 
@@ -39,50 +46,44 @@ public:
   using reference = value&;
   using rvalue_reference = value&&;
   using const_reference = const value&;
-  using self = Queue<T>;
+  using self = Queue<T, Allocator>;
 
   Queue() = default;
 
   Queue(std::size_t capacity)
-      : _capacity{capacity}, _elements{_allocator.allocate(capacity)},
-        _head{_elements}, _tail{_head} {
+      : _capacity{capacity}, _elements{_allocator.allocate(capacity)} {
     QUEUE_DEBUG_MS("Queue Ctor capacity");
   };
   Queue(std::initializer_list<T> list) : Queue(list.size() + 2) {
     // helpers::printf("Queue list ctor");
     for (const T& i : list) {
-      _allocator.construct(_tail, i);
-      ++_tail;
+      push_back(i);
     }
   };
 
   ~Queue() {
     QUEUE_DEBUG_MS("Queue Dtor");
-    for (pointer i{_head}; i != _tail; ++i) {
-      _allocator.destruct(i);
-    };
-    _allocator.deallocate(_elements);
+    destroyAll();
+    _allocator.deallocate(_elements, _capacity);
   };
 
   Queue(const self& other)
       : _allocator{other._allocator}, _capacity{other._capacity},
-        _elements{_allocator.allocate(_capacity)},
-        _head{_elements + (other._head - other._elements)},
-        _tail{_elements + (other._tail - other._elements)} {
+        _elements{_allocator.allocate(_capacity)} {
     QUEUE_DEBUG_MS("Queue Copy Ctor");
-    for (pointer i{other._head}, ele{_head}; i < other._tail; ++i, ++ele) {
-      _allocator.construct(ele, *i);
-    };
+    for (const_reference i : other) {
+      push_back(i);
+    }
   };
 
   Queue(self&& other) noexcept
       : _allocator{std::move(other._allocator)}, _capacity{other._capacity},
-        _elements{other._elements}, _head{other._head}, _tail{other._tail} {
+        _elements{other._elements}, _head{other._head}, _size{other._size} {
     QUEUE_DEBUG_MS("Queue Move Ctor");
     other._capacity = 0;
-    other._head = nullptr;
-    other._tail = nullptr;
     other._elements = nullptr;
+    other._head = 0;
+    other._size = 0;
   };
 
   self& operator=(const self& other) {
@@ -102,147 +103,114 @@ public:
   void shrink_to_fit(){};
   void resize(){};
 
+  void reserve(std::size_t capacity) {
+    if (capacity > _capacity) {
+      reallocate(capacity);
+    }
+  }
+
   void push_back(const_reference element) {
-    if (_tail == _elements + _capacity && !is_full()) {
-      shiftLeft(end(), 1);
-      --_tail;
-    } else if (is_full()) {
-      std::size_t newCapacity{getNewCapacity()};
-      reallocate(newCapacity);
-      return push_back(element);
+    if (is_full()) {
+      // element may live in this queue, copy it before the storage moves
+      value copy{element};
+      reallocate(getNewCapacity());
+      return push_back(std::move(copy));
     }
-    _allocator.construct(_tail, element);
-    ++_tail;
+    _allocator.construct(_elements + physicalIndex(_size), element);
+    ++_size;
   };
   void push_back(rvalue_reference element) {
-    if (_tail == _elements + _capacity && !is_full()) {
-      shiftLeft(end(), 1);
-      --_tail;
-    } else if (is_full()) {
-      std::size_t newCapacity{getNewCapacity()};
-      reallocate(newCapacity);
-      return push_back(std::move(element));
+    if (is_full()) {
+      value moved{std::move(element)};
+      reallocate(getNewCapacity());
+      return push_back(std::move(moved));
     }
-    _allocator.construct(_tail, std::move(element));
-    ++_tail;
+    _allocator.construct(_elements + physicalIndex(_size), std::move(element));
+    ++_size;
   };
 
+  // appends count elements read from first, growing at most once
+  template <std::input_iterator InputIterator>
+  void push_back_n(InputIterator first, std::size_t count) {
+    if (size() + count > _capacity) {
+      reallocate(getNewCapacity(size() + count));
+    }
+    for (std::size_t i{}; i < count; ++i, ++first) {
+      _allocator.construct(_elements + physicalIndex(_size), *first);
+      ++_size;
+    }
+  }
+
   value pop_front() {
     value ele{std::move(front())};
-    ++_head;
+    _allocator.destruct(_elements + _head);
+    advanceHead(1);
+    --_size;
     return ele;
   };
 
-  iterator insert(iterator pos, const_reference element) {
-    if (!is_full()) {
-      if (_tail + 1 <= _elements + _capacity) {
-        shiftRight(pos._current - 1, 1);
-        _allocator.construct(pos._current, element);
-        return {pos._current};
-      } else {
-        shiftLeft(pos._current, 1);
-        _allocator.construct(pos._current - 1, element);
-        return {pos._current - 1};
+  // moves up to count elements from the front to out, returns how many
+  // were moved. The elements are read as (at most) two contiguous runs.
+  template <typename OutputIterator>
+  std::size_t pop_front_n(OutputIterator out, std::size_t count) {
+    count = std::min(count, size());
+    std::size_t firstRun{std::min(count, _capacity - _head)};
+    pointer runs[][2]{{_elements + _head, _elements + _head + firstRun},
+                      {_elements, _elements + (count - firstRun)}};
+    for (auto [runBegin, runEnd] : runs) {
+      out = std::move(runBegin, runEnd, out);
+      for (pointer i{runBegin}; i != runEnd; ++i) {
+        _allocator.destruct(i);
       }
-    } else {
-      difference_type distance{pos._current - _head};
-      std::size_t newCapacity{getNewCapacity()};
-      reallocate(newCapacity);
-      return insert(iterator{_head + distance}, element);
     }
+    advanceHead(count);
+    _size -= count;
+    return count;
+  }
+
+  iterator insert(iterator pos, const_reference element) {
+    value copy{element};
+    return insert(pos, std::move(copy));
   };
 
   iterator insert(iterator pos, rvalue_reference element) {
-    if (!is_full()) {
-      if (_tail + 1 <= _elements + _capacity) {
-        shiftRight(pos._current - 1, 1);
-        _allocator.construct(pos._current, std::move(element));
-        return {pos._current};
-      } else {
-        shiftLeft(pos._current, 1);
-        _allocator.construct(pos._current - 1, std::move(element));
-        return {pos._current - 1};
-      }
-    } else {
-      difference_type distance{pos._current - _head};
-      std::size_t newCapacity{getNewCapacity()};
-      reallocate(newCapacity);
-      return insert(iterator{_head + distance}, std::move(element));
-    }
+    std::size_t index{pos._index};
+    openGap(index, 1);
+    _allocator.construct(_elements + physicalIndex(index), std::move(element));
+    return {this, index};
   };
 
   template <typename InputIterator>
   iterator insert(iterator pos, InputIterator start, InputIterator end) {
-    std::size_t totalNewBlocks{static_cast<std::size_t>(end - start)};
-    difference_type distance{pos._current - _head};
-    if (size() + totalNewBlocks <= _capacity) {
-      std::size_t freeBlocksAfterInsert{_capacity - (size() + totalNewBlocks)};
-      std::size_t freeBlocksEachSideAfterInsert{
-          static_cast<std::size_t>(std::round(freeBlocksAfterInsert * 0.5))};
-      std::size_t leftFreeBlocks{static_cast<std::size_t>(_head - _elements)};
-      std::size_t rightFreeBlocks(_capacity + _elements - _tail);
-      std::size_t leftMoveDistance{
-          leftFreeBlocks > freeBlocksEachSideAfterInsert
-              ? leftFreeBlocks - freeBlocksEachSideAfterInsert
-              : 0};
-      if (leftMoveDistance) {
-        shiftLeft(pos._current, leftMoveDistance);
-      }
-      std::size_t remainingFreeBlocks{
-          freeBlocksEachSideAfterInsert > leftMoveDistance
-              ? freeBlocksEachSideAfterInsert - leftMoveDistance
-              : 0};
-      std::size_t rightMoveDistance{
-          rightFreeBlocks > freeBlocksEachSideAfterInsert + remainingFreeBlocks
-              ? rightFreeBlocks - freeBlocksEachSideAfterInsert -
-                    remainingFreeBlocks
-              : 0};
-      if (rightMoveDistance) {
-        shiftRight(pos._current - 1, rightMoveDistance);
-      }
-      std::size_t i{};
-      while (start != end) {
-        _allocator.construct(_head + distance + i, *start);
-        ++start;
-        ++i;
-      }
-      return {_head + distance};
-    } else {
-      std::size_t newCapacity{getNewCapacity(size() + totalNewBlocks)};
-      reallocate(newCapacity);
-      return insert(iterator{_head + distance}, start, end);
+    std::size_t count{static_cast<std::size_t>(std::distance(start, end))};
+    std::size_t index{pos._index};
+    openGap(index, count);
+    for (std::size_t i{index}; start != end; ++start, ++i) {
+      _allocator.construct(_elements + physicalIndex(i), *start);
     }
+    return {this, index};
   }
 
   iterator erase(iterator start, iterator end) {
-    difference_type distance{end - start};
-    for (iterator i{start}; i != end; ++i) {
-      _allocator.destruct(i._current);
+    std::size_t first{start._index};
+    std::size_t count{end._index - start._index};
+    for (std::size_t i{first}; i + count < _size; ++i) {
+      (*this)[i] = std::move((*this)[i + count]);
     }
-    for (pointer i{start._current}; i < _tail - distance; ++i) {
-      _allocator.construct(i, std::move(*(i + distance)));
+    for (std::size_t i{_size - count}; i < _size; ++i) {
+      _allocator.destruct(_elements + physicalIndex(i));
     }
-    _tail -= distance;
-    return {start._current};
+    _size -= count;
+    return {this, first};
   };
 
-  iterator erase(iterator pos) {
-    _allocator.destruct(pos._current);
-    for (pointer i{pos._current}; i < _tail - 1; ++i) {
-      _allocator.construct(i, std::move(*(i + 1)));
-    }
-    --_tail;
-    return {pos._current};
-  };
+  iterator erase(iterator pos) { return erase(pos, pos + 1); };
 
-  reference front() { return *_head; };
-  reference front() const { return *_head; };
+  reference front() { return _elements[_head]; };
+  reference front() const { return _elements[_head]; };
 
-  reference back() { return *(_tail - 1); };
-  reference back() const { return *(_tail - 1); };
-
-  pointer data() { return _elements; };
-  pointer data() const { return _elements; };
+  reference back() { return (*this)[_size - 1]; };
+  reference back() const { return (*this)[_size - 1]; };
 
   reference at(std::size_t index) {
     validateIndex(index);
@@ -253,22 +221,24 @@ public:
     return (*this)[index];
   };
 
-  reference operator[](std::size_t index) { return *(_head + index); };
-  reference operator[](std::size_t index) const { return *(_head + index); };
+  reference operator[](std::size_t index) {
+    return _elements[physicalIndex(index)];
+  };
+  reference operator[](std::size_t index) const {
+    return _elements[physicalIndex(index)];
+  };
 
   bool empty() const noexcept { return size() == 0; };
   bool is_full() const noexcept { return size() == _capacity; };
   std::size_t capacity() const noexcept { return _capacity; };
-  std::size_t size() const noexcept {
-    return static_cast<std::size_t>(_tail - _head);
-  };
+  std::size_t size() const noexcept { return _size; };
 
-  iterator begin() { return iterator{_head}; };
-  iterator end() { return iterator{_tail}; };
-  iterator begin() const { return iterator{_head}; };
-  iterator end() const { return iterator{_tail}; };
-  iterator cbegin() const { return iterator{_head}; };
-  iterator cend() const { return iterator{_tail}; };
+  iterator begin() { return iterator{this, 0}; };
+  iterator end() { return iterator{this, _size}; };
+  iterator begin() const { return iterator{this, 0}; };
+  iterator end() const { return iterator{this, _size}; };
+  iterator cbegin() const { return iterator{this, 0}; };
+  iterator cend() const { return iterator{this, _size}; };
 
   void swap(self& other) noexcept {
     using std::swap;
@@ -276,7 +246,7 @@ public:
     swap(_capacity, other._capacity);
     swap(_elements, other._elements);
     swap(_head, other._head);
-    swap(_tail, other._tail);
+    swap(_size, other._size);
   }
 
   void friend swap(self& e1, self& e2) noexcept { e1.swap(e2); };
@@ -285,8 +255,24 @@ private:
   Allocator _allocator{};
   std::size_t _capacity{};
   pointer _elements{};
-  pointer _head{};
-  pointer _tail{};
+  // slot of the front element, the others follow it and wrap around
+  std::size_t _head{};
+  std::size_t _size{};
+
+  std::size_t physicalIndex(std::size_t index) const noexcept {
+    std::size_t i{_head + index};
+    return i >= _capacity ? i - _capacity : i;
+  }
+
+  void advanceHead(std::size_t count) noexcept {
+    _head = physicalIndex(count);
+  }
+
+  void destroyAll() {
+    for (std::size_t i{}; i < _size; ++i) {
+      _allocator.destruct(_elements + physicalIndex(i));
+    }
+  }
 
   void validateIndex(std::size_t index) const {
     if (size() > 0 && index >= size()) {
@@ -299,44 +285,33 @@ private:
                     static_cast<std::size_t>(std::round(growRate * _capacity)));
   }
 
+  // moves the elements to a new allocation, the front lands in slot 0
   void reallocate(std::size_t capacity) {
     // helpers::printf("Reallocating with ", capacity);
     pointer newSpace{_allocator.allocate(capacity)};
-
-    pointer newHead{newSpace};
-    pointer newTail{newHead};
-    for (pointer i{_head}; i < _tail; ++i) {
-      _allocator.construct(newTail, std::move(*i));
-      _allocator.destruct(i);
-      ++newTail;
+    for (std::size_t i{}; i < _size; ++i) {
+      pointer old{_elements + physicalIndex(i)};
+      _allocator.construct(newSpace + i, std::move(*old));
+      _allocator.destruct(old);
     }
     std::swap(_elements, newSpace);
-    _allocator.deallocate(newSpace);
+    _allocator.deallocate(newSpace, _capacity);
     _capacity = capacity;
-    _head = newHead;
-    _tail = newTail;
+    _head = 0;
   }
 
-  void shiftLeft(iterator startPos, std::size_t units = 1) {
-    if (_head - units < _elements) {
-      throw std::runtime_error("shiftLeft overflow");
+  // count unconstructed slots at index, the elements after it move back
+  void openGap(std::size_t index, std::size_t count) {
+    if (_size + count > _capacity) {
+      reallocate(getNewCapacity(_size + count));
     }
-    for (pointer i{_head}; i < startPos._current; ++i) {
-      pointer pos{i - units};
-      _allocator.construct(pos, std::move(*i));
+    for (std::size_t i{_size}; i > index; --i) {
+      pointer from{_elements + physicalIndex(i - 1)};
+      _allocator.construct(_elements + physicalIndex(i - 1 + count),
+                           std::move(*from));
+      _allocator.destruct(from);
     }
-    _head -= units;
-  }
-
-  void shiftRight(iterator startPos, std::size_t units = 1) {
-    if (_tail + units > _elements + _capacity) {
-      throw std::runtime_error("shiftRight overflow");
-    }
-    for (pointer i{_tail - 1}; i > startPos._current; --i) {
-      pointer pos{i + units};
-      _allocator.construct(pos, std::move(*i));
-    }
-    _tail += units;
+    _size += count;
   }
 
 public:
@@ -355,35 +330,41 @@ public:
   public:
     using iterator_category = Queue::iterator_category;
     using difference_type = Queue::difference_type;
+    using value_type = T;
+    using pointer = T*;
+    using reference = T&;
 
     Iterator() = default;
 
   private:
-    Iterator(pointer current) : _current{current} {};
-    pointer _current;
+    Iterator(const Queue* queue, std::size_t index)
+        : _queue{const_cast<Queue*>(queue)}, _index{index} {};
+    Queue* _queue{nullptr};
+    std::size_t _index{};
 
   public:
-    reference operator*() { return *_current; };
-    pointer operator->() { return _current; };
+    reference operator*() const { return (*_queue)[_index]; };
+    pointer operator->() const { return &(*_queue)[_index]; };
 
     Iterator& operator++() {
-      ++_current;
+      ++_index;
       return *this;
     }
 
     Iterator operator++(int) {
       Iterator tmp{*this};
-      ++_current;
+      ++_index;
       return tmp;
     }
 
-    Iterator& operator+=(int index) {
-      _current += index;
+    Iterator& operator+=(difference_type index) {
+      _index += static_cast<std::size_t>(index);
       return *this;
     }
 
     Iterator operator+(const difference_type index) const {
-      return _current + index;
+      Iterator tmp{*this};
+      return tmp += index;
     }
 
     friend Iterator operator+(const difference_type index,
@@ -392,43 +373,39 @@ public:
     }
 
     Iterator& operator--() {
-      --_current;
+      --_index;
       return *this;
     }
 
     Iterator operator--(int) {
       Iterator tmp{*this};
-      --_current;
-      return *this;
+      --_index;
+      return tmp;
     }
 
-    Iterator& operator-=(int index) {
-      _current -= index;
+    Iterator& operator-=(difference_type index) {
+      _index -= static_cast<std::size_t>(index);
       return *this;
     }
 
     Iterator operator-(const difference_type index) const {
-      return _current - index;
-    }
-
-    friend Iterator operator-(const difference_type index,
-                              const Iterator& other) {
-      return other - index;
+      Iterator tmp{*this};
+      return tmp -= index;
     }
 
     difference_type operator-(const Iterator& other) const {
-      return _current > other._current ? _current - other._current
-                                       : other._current - _current;
+      return static_cast<difference_type>(_index) -
+             static_cast<difference_type>(other._index);
     }
 
     bool operator==(const Iterator& other) const {
-      return _current == other._current;
+      return _index == other._index;
     }
 
     bool operator!=(const Iterator& other) const { return !(*this == other); }
 
     reference operator[](difference_type index) const {
-      return _current[index];
+      return *(*this + index);
     }
   };
-};
\ No newline at end of file
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <allocator.hpp>
 #include <cmath>
 #include <concept.hpp>
@@ -39,7 +40,7 @@ public:
   using reference = value&;
   using rvalue_reference = value&&;
   using const_reference = const value&;
-  using self = SimpleDeque<T>;
+  using self = SimpleDeque<T, Allocator>;
 
   SimpleDeque() = default;
 
@@ -67,7 +68,7 @@ public:
     for (pointer i{_head}; i != _tail; ++i) {
       _allocator.destruct(i);
     };
-    _allocator.deallocate(_elements);
+    _allocator.deallocate(_elements, _capacity);
   };
 
   SimpleDeque(const self& other)
@@ -110,8 +111,9 @@ public:
 
   void push_back(const_reference element) {
     if (_tail == _elements + _capacity && !is_full()) {
-      shiftLeft(end(), 1);
-      --_tail;
+      std::size_t units{spareUnits(_head - _elements)};
+      shiftLeft(end(), units);
+      _tail -= units;
     } else if (is_full()) {
       std::size_t newCapacity{getNewCapacity()};
       reallocate(newCapacity);
@@ -122,8 +124,9 @@ public:
   };
   void push_back(rvalue_reference element) {
     if (_tail == _elements + _capacity && !is_full()) {
-      shiftLeft(end(), 1);
-      --_tail;
+      std::size_t units{spareUnits(_head - _elements)};
+      shiftLeft(end(), units);
+      _tail -= units;
     } else if (is_full()) {
       std::size_t newCapacity{getNewCapacity()};
       reallocate(newCapacity);
@@ -135,8 +138,9 @@ public:
 
   void push_front(const_reference element) {
     if (_head == _elements && !is_full()) {
-      shiftRight(begin() - 1, 1);
-      ++_head;
+      std::size_t units{spareUnits(_elements + _capacity - _tail)};
+      shiftRight(begin() - 1, units);
+      _head += units;
     } else if (is_full()) {
       std::size_t newCapacity{getNewCapacity()};
       reallocate(newCapacity);
@@ -147,8 +151,9 @@ public:
   };
   void push_front(rvalue_reference element) {
     if (_head == _elements && !is_full()) {
-      shiftRight(begin() - 1, 1);
-      ++_head;
+      std::size_t units{spareUnits(_elements + _capacity - _tail)};
+      shiftRight(begin() - 1, units);
+      _head += units;
     } else if (is_full()) {
       std::size_t newCapacity{getNewCapacity()};
       reallocate(newCapacity);
@@ -349,12 +354,19 @@ private:
       ++newTail;
     }
     std::swap(_elements, newSpace);
-    _allocator.deallocate(newSpace);
+    _allocator.deallocate(newSpace, _capacity);
     _capacity = capacity;
     _head = newHead;
     _tail = newTail;
   }
 
+  // how far to move the elements when one end runs into the storage edge:
+  // half of the free space on the other side, so pushing at one end while
+  // popping at the other (a queue) shifts O(1) elements per push on average
+  std::size_t spareUnits(difference_type freeSpace) const {
+    return std::max<std::size_t>(1, static_cast<std::size_t>(freeSpace) / 2);
+  }
+
   void shiftLeft(iterator startPos, std::size_t units = 1) {
     if (_head - units < _elements) {
       throw std::runtime_error("shiftLeft overflow");
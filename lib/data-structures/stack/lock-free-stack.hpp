@@ -0,0 +1,172 @@
+#pragma once
+
+#include <allocator.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <epoch.hpp>
+#include <optional>
+#include <utility>
+
+// Treiber stack: a singly linked list whose head is swapped with a CAS, for
+// free lists and other LIFOs shared between threads.
+// Popped nodes go through epoch reclamation, so a thread that read the head
+// can still follow its _next, and a node is never reused under a pending
+// CAS (no ABA).
+// When a CAS on the head fails the thread backs off into an elimination
+// array instead of retrying at once: a push parks its node in a random slot
+// for a moment and a pop that lands on the slot takes it, so the pair
+// completes without touching the head at all. EliminationSlots = 0 turns it
+// off.
+// Nodes are allocated through Allocator rebound to the node type, which has
+// to be stateless: reclamation frees them later, from any thread.
+template <typename T, typename Allocator = Allocator<T>,
+          std::size_t EliminationSlots = 16>
+class LockFreeStack {
+  inline static constexpr std::size_t CACHE_LINE{64};
+  // polls of its slot a parked push makes before it gives up
+  inline static constexpr int ELIMINATION_WAIT{64};
+
+  struct Node {
+    T _value;
+    Node* _next{nullptr};
+  };
+
+  using NodeAllocator = typename Allocator::template rebind<Node>::other;
+
+  // a slot holds EMPTY, a parked Node* or TAKEN once a pop claimed it
+  struct alignas(CACHE_LINE) Slot {
+    std::atomic<std::uintptr_t> _state{EMPTY};
+  };
+
+  inline static constexpr std::uintptr_t EMPTY{0};
+  inline static constexpr std::uintptr_t TAKEN{1};
+
+public:
+  using value_type = T;
+  using reference = T&;
+  using rvalue_reference = T&&;
+  using const_reference = const T&;
+  using self = LockFreeStack<T, Allocator, EliminationSlots>;
+
+private:
+  alignas(CACHE_LINE) std::atomic<Node*> _head{nullptr};
+  Slot _slots[EliminationSlots ? EliminationSlots : 1]{};
+
+  static Node* createNode(T&& value) {
+    NodeAllocator allocator{};
+    Node* node{allocator.allocate(1)};
+    allocator.construct(node, Node{std::move(value)});
+    return node;
+  }
+
+  static void destroyNode(void* pointer) {
+    NodeAllocator allocator{};
+    Node* node{static_cast<Node*>(pointer)};
+    allocator.destruct(node);
+    allocator.deallocate(node, 1);
+  }
+
+  // cheap per thread xorshift, only spreads threads over the slots
+  static Slot& randomSlot(Slot* slots) {
+    thread_local std::uint32_t state{static_cast<std::uint32_t>(
+        reinterpret_cast<std::uintptr_t>(&state) | 1)};
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return slots[state % EliminationSlots];
+  }
+
+  // parks node for a pop to take, true if one did
+  bool eliminatePush(Node* node) {
+    Slot& slot{randomSlot(_slots)};
+    auto parked{reinterpret_cast<std::uintptr_t>(node)};
+    std::uintptr_t expected{EMPTY};
+    if (!slot._state.compare_exchange_strong(expected, parked)) {
+      return false;
+    }
+    for (int i{}; i < ELIMINATION_WAIT; ++i) {
+      if (slot._state.load(std::memory_order_acquire) == TAKEN) {
+        slot._state.store(EMPTY, std::memory_order_release);
+        return true;
+      }
+    }
+    expected = parked;
+    if (slot._state.compare_exchange_strong(expected, EMPTY)) {
+      return false;
+    }
+    // a pop took it while we were withdrawing
+    slot._state.store(EMPTY, std::memory_order_release);
+    return true;
+  }
+
+  // takes a node parked by a push, nullptr if the slot had none
+  Node* eliminatePop() {
+    Slot& slot{randomSlot(_slots)};
+    std::uintptr_t parked{slot._state.load(std::memory_order_acquire)};
+    if (parked == EMPTY || parked == TAKEN ||
+        !slot._state.compare_exchange_strong(parked, TAKEN)) {
+      return nullptr;
+    }
+    return reinterpret_cast<Node*>(parked);
+  }
+
+  void pushNode(Node* node) {
+    node->_next = _head.load(std::memory_order_relaxed);
+    while (!_head.compare_exchange_weak(node->_next, node)) {
+      if constexpr (EliminationSlots > 0) {
+        if (eliminatePush(node)) {
+          return;
+        }
+        node->_next = _head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+public:
+  LockFreeStack() = default;
+
+  // only one thread may be left using the stack
+  ~LockFreeStack() {
+    Node* node{_head.load(std::memory_order_acquire)};
+    while (node) {
+      destroyNode(std::exchange(node, node->_next));
+    }
+  }
+
+  // other threads hold on to the head, the stack stays put
+  LockFreeStack(const self&) = delete;
+  self& operator=(const self&) = delete;
+
+  void push(const_reference element) { pushNode(createNode(T{element})); }
+  void push(rvalue_reference element) {
+    pushNode(createNode(std::move(element)));
+  }
+
+  std::optional<T> pop() {
+    epoch::Guard guard{};
+    Node* head{_head.load(std::memory_order_acquire)};
+    while (head) {
+      if (_head.compare_exchange_weak(head, head->_next)) {
+        std::optional<T> value{std::move(head->_value)};
+        epoch::retire(head, destroyNode);
+        return value;
+      }
+      if constexpr (EliminationSlots > 0) {
+        // a parked node was never in the stack, nobody else can see it
+        if (Node* node{eliminatePop()}) {
+          std::optional<T> value{std::move(node->_value)};
+          destroyNode(node);
+          return value;
+        }
+        head = _head.load(std::memory_order_acquire);
+      }
+    }
+    return std::nullopt;
+  }
+
+  // only a snapshot while other threads are working on it
+  bool empty() const noexcept {
+    return _head.load(std::memory_order_acquire) == nullptr;
+  }
+};
@@ -219,14 +219,14 @@ private:
 
     bool is_leaf() { return !_right && !_left; }
 
-    void* operator new(std::size_t size) {
+    void* operator new(std::size_t) {
       typename Allocator::template rebind<Node>::other alloc{};
-      return static_cast<void*>(alloc.allocate(size));
+      return static_cast<void*>(alloc.allocate(1));
     }
 
     void operator delete(void* p, std::size_t) {
       typename Allocator::template rebind<Node>::other alloc{};
-      alloc.deallocate(static_cast<Node*>(p));
+      alloc.deallocate(static_cast<Node*>(p), 1);
       return;
     }
 
@@ -8,6 +8,7 @@
 #include <numeric>
 #include <queue.hpp>
 #include <static-circular-buffer.hpp>
+#include <type_traits>
 #include <utility>
 #include <variant>
 
@@ -36,6 +37,12 @@ private:
   inline static constexpr std::size_t maxChildren{2 * DEGREE};
   // (maxKey - 1)/ 2 = minKey
   inline static constexpr std::size_t midKeyIndex{DEGREE - 1};
+  // arena backed nodes holding trivially destructible keys / data own
+  // nothing, they are reclaimed when the arena is released
+  inline static constexpr bool skipNodeDestruction{
+      concepts::MonotonicAllocator<Allocator> &&
+      std::is_trivially_destructible_v<T> &&
+      std::is_trivially_destructible_v<Data>};
 
   class Node {
     friend BPlusTree;
@@ -94,6 +101,17 @@ private:
     NodeLeaf& operator=(const NodeLeaf&) = default;
     NodeLeaf& operator=(NodeLeaf&&) = default;
 
+    void* operator new(std::size_t) {
+      allocator alloc{};
+      return static_cast<void*>(alloc.allocate(1));
+    }
+
+    void operator delete(void* p, std::size_t) {
+      allocator alloc{};
+      alloc.deallocate(static_cast<NodeLeaf*>(p), 1);
+      return;
+    }
+
     bool is_leaf() override { return true; }
 
     std::size_t _get_key_upper_bound_index(const T& key) override {
@@ -142,6 +160,17 @@ private:
 
     NodeNonLeaf() = default;
 
+    void* operator new(std::size_t) {
+      allocator alloc{};
+      return static_cast<void*>(alloc.allocate(1));
+    }
+
+    void operator delete(void* p, std::size_t) {
+      allocator alloc{};
+      alloc.deallocate(static_cast<NodeNonLeaf*>(p), 1);
+      return;
+    }
+
     bool is_leaf() override { return false; }
     std::size_t _get_key_upper_bound_index(const T& key) override {
       if (key >= this->_keys.back()) {
@@ -303,7 +332,7 @@ public:
 
   BPlusTree() = default;
   ~BPlusTree() {
-    if (_root) {
+    if (_root && !skipNodeDestruction) {
       _walk_node_depth_first_postorder(_root, [](Node* node) { delete node; });
     }
   };
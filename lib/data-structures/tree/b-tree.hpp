@@ -50,6 +50,17 @@ public:
     bool has_minimum_children() { return _children.size() == minChildren; }
     bool is_leaf() { return _children.empty(); }
 
+    void* operator new(std::size_t) {
+      Allocator<Node> alloc{};
+      return static_cast<void*>(alloc.allocate(1));
+    }
+
+    void operator delete(void* p, std::size_t) {
+      Allocator<Node> alloc{};
+      alloc.deallocate(static_cast<Node*>(p), 1);
+      return;
+    }
+
     // assuming previous node exists and have enough keys
     void borrow_from_previous(std::size_t index) {
       // we move the parent key + data at (index - 1) to child at index
@@ -1,5 +1,6 @@
 #pragma once
 #include <algorithm>
+#include <allocator.hpp>
 #include <concept.hpp>
 #include <functional>
 #include <helpers.hpp>
@@ -21,7 +22,9 @@
 #endif
 
 namespace trees {
-template <concepts::Comparable T> class BST {
+template <concepts::Comparable T,
+          concepts::Allocator Allocator = Allocator<T>>
+class BST {
 private:
   struct Node;
 
@@ -31,7 +34,7 @@ public:
   using reference = T&;
   using rvalue_reference = T&&;
   using const_reference = const T&;
-  using self = BST<T>;
+  using self = BST<T, Allocator>;
 
   BST() = default;
   ~BST() {
@@ -164,6 +167,17 @@ private:
     value_type value{};
     Node* left{nullptr};
     Node* right{nullptr};
+
+    void* operator new(std::size_t) {
+      typename Allocator::template rebind<Node>::other alloc{};
+      return static_cast<void*>(alloc.allocate(1));
+    }
+
+    void operator delete(void* p, std::size_t) {
+      typename Allocator::template rebind<Node>::other alloc{};
+      alloc.deallocate(static_cast<Node*>(p), 1);
+      return;
+    }
   };
 
   Node* _root{nullptr};
@@ -221,14 +221,14 @@ private:
       return;
     }
 
-    void* operator new(std::size_t size) {
+    void* operator new(std::size_t) {
       typename Allocator::template rebind<Node>::other alloc{};
-      return static_cast<void*>(alloc.allocate(size));
+      return static_cast<void*>(alloc.allocate(1));
     }
 
     void operator delete(void* p, std::size_t) {
       typename Allocator::template rebind<Node>::other alloc{};
-      alloc.deallocate(static_cast<Node*>(p));
+      alloc.deallocate(static_cast<Node*>(p), 1);
       return;
     }
 
@@ -253,16 +253,16 @@ private:
 
     bool is_leaf() { return _children.size() == 0; }
 
-    void* operator new(std::size_t size) {
+    void* operator new(std::size_t) {
       typename Allocator::template rebind<Node>::other alloc{};
-      return static_cast<void*>(alloc.allocate(size));
+      return static_cast<void*>(alloc.allocate(1));
     }
 
     void operator delete(void* p, std::size_t) {
       std::cout << "NODE DESTRUCTOR"
                 << "\n";
       typename Allocator::template rebind<Node>::other alloc{};
-      alloc.deallocate(static_cast<Node*>(p));
+      alloc.deallocate(static_cast<Node*>(p), 1);
       return;
     }
 
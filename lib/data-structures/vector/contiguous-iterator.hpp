@@ -0,0 +1,81 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Random access iterator over a plain array, for containers whose elements
+// are contiguous but live somewhere other than a Vector (inline storage, a
+// mapped file). Unlike a raw pointer it carries the nested typedefs the sort::
+// algorithms look up through Iter::value_type.
+template <typename T> class ContiguousIterator {
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using iterator_concept = std::contiguous_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = std::remove_cv_t<T>;
+  using element_type = T;
+  using pointer = T*;
+  using reference = T&;
+
+private:
+  T* _current{nullptr};
+
+public:
+  ContiguousIterator() = default;
+  ContiguousIterator(T* p) : _current{p} {}
+
+  // iterator -> const_iterator
+  operator ContiguousIterator<const T>() const { return _current; }
+
+  reference operator*() const { return *_current; }
+  pointer operator->() const { return _current; }
+  reference operator[](difference_type index) const {
+    return _current[index];
+  }
+
+  ContiguousIterator& operator++() {
+    ++_current;
+    return *this;
+  }
+  ContiguousIterator operator++(int) {
+    ContiguousIterator tmp{*this};
+    ++_current;
+    return tmp;
+  }
+  ContiguousIterator& operator--() {
+    --_current;
+    return *this;
+  }
+  ContiguousIterator operator--(int) {
+    ContiguousIterator tmp{*this};
+    --_current;
+    return tmp;
+  }
+
+  ContiguousIterator& operator+=(difference_type index) {
+    _current += index;
+    return *this;
+  }
+  ContiguousIterator& operator-=(difference_type index) {
+    _current -= index;
+    return *this;
+  }
+  ContiguousIterator operator+(difference_type index) const {
+    return _current + index;
+  }
+  friend ContiguousIterator operator+(difference_type index,
+                                      const ContiguousIterator& other) {
+    return other + index;
+  }
+  ContiguousIterator operator-(difference_type index) const {
+    return _current - index;
+  }
+  difference_type operator-(const ContiguousIterator& other) const {
+    return _current - other._current;
+  }
+
+  bool operator==(const ContiguousIterator& other) const = default;
+  auto operator<=>(const ContiguousIterator& other) const = default;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+// Growth policies decide the capacity Vector reallocates to once it runs out
+// of space. next_capacity gets the current capacity and the capacity that is
+// at least required, and gets the allocator type so a policy can ask it about
+// its real block sizes.
+
+// capacity * Num / Den rounded to nearest, e.g. GrowthFactor<3, 2> or
+// GrowthFactor<2, 1>
+template <std::size_t Num, std::size_t Den> struct GrowthFactor {
+  static_assert(Num > Den, "growth factor must be bigger than 1");
+
+  template <typename Allocator>
+  static constexpr std::size_t next_capacity(std::size_t capacity,
+                                             std::size_t required) {
+    return std::max(
+        {required, (capacity * Num + Den / 2) / Den, std::size_t{2}});
+  }
+};
+
+using GrowHalf = GrowthFactor<3, 2>;
+using GrowDouble = GrowthFactor<2, 1>;
+
+// Grows like Base, then rounds up to the block the allocator would hand out
+// anyway, so the slack at the end of the block becomes usable capacity.
+// Allocators opt in with a static good_size(count) returning the number of
+// elements that fit in the block serving count elements; for the others this
+// is just Base.
+template <typename Base = GrowHalf> struct AllocatorSizedGrowth {
+  template <typename Allocator>
+  static constexpr std::size_t next_capacity(std::size_t capacity,
+                                             std::size_t required) {
+    std::size_t next{
+        Base::template next_capacity<Allocator>(capacity, required)};
+    if constexpr (requires { Allocator::good_size(next); }) {
+      return std::max(next, Allocator::good_size(next));
+    } else {
+      return next;
+    }
+  }
+};
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <contiguous-iterator.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <growth-policy.hpp>
+#include <iterator>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+// Vector whose elements live in a memory mapped file, for columns bigger
+// than RAM. The kernel pages data in and out on demand; growing extends the
+// file with ftruncate and the mapping with mremap.
+// The file starts with a small header recording the element size and count,
+// so reopening the same path gives the data back without copying it.
+// Only for trivially copyable T, elements are stored as raw bytes. Like
+// Vector, iterators and references are invalidated when it grows.
+//
+//   MappedVector<double> column{"prices.col"};
+//   column.append(prices.begin(), prices.end());
+//   algorithms::sort::quicksort(column.begin(), column.end());
+template <typename T, typename GrowthPolicy = GrowDouble> class MappedVector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MappedVector stores elements as raw bytes");
+
+  struct Header {
+    std::uint64_t _magic;
+    std::uint64_t _elementSize;
+    std::uint64_t _size;
+  };
+
+  inline static constexpr std::uint64_t MAGIC{0x3130305443455644}; // DVECT001
+  // elements start here, keeps them aligned within the page aligned mapping
+  inline static constexpr std::size_t DATA_OFFSET{
+      std::max<std::size_t>(64, alignof(T))};
+
+public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using Iterator = ContiguousIterator<T>;
+  using ConstIterator = ContiguousIterator<const T>;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  class OutOfRangeException : public std::exception {
+    using std::exception::what;
+
+  private:
+    std::string message;
+
+  public:
+    OutOfRangeException(std::string msg) : message{msg} {}
+    std::string what() { return message; }
+  };
+
+private:
+  std::string _path{};
+  int _fd{-1};
+  std::byte* _map{nullptr};
+  std::size_t _mappedBytes{};
+  std::size_t _space{};
+
+  Header& header() const { return *reinterpret_cast<Header*>(_map); }
+  T* elements() const { return reinterpret_cast<T*>(_map + DATA_OFFSET); }
+
+  void validateIndex(std::size_t index) const {
+    if (index >= size()) {
+      throw OutOfRangeException{"Index out of range"};
+    }
+  };
+
+  [[noreturn]] void fail(const char* what) const {
+    throw std::system_error{errno, std::generic_category(),
+                            std::string{"MappedVector "} + what + " " + _path};
+  }
+
+  static std::size_t page_size() {
+    static const std::size_t pageSize{
+        static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+    return pageSize;
+  }
+
+  // whole pages able to hold at least capacity elements
+  static std::size_t bytes_for(std::size_t capacity) {
+    std::size_t bytes{DATA_OFFSET + capacity * sizeof(T)};
+    return (bytes + page_size() - 1) / page_size() * page_size();
+  }
+
+  // on failure the old mapping, capacity and file length are kept
+  void map(std::size_t bytes) {
+    if (::ftruncate(_fd, static_cast<off_t>(bytes)) != 0) {
+      fail("ftruncate");
+    }
+    void* p{};
+    if (_map) {
+#ifdef __linux__
+      // leaves the old mapping in place when it fails
+      p = ::mremap(_map, _mappedBytes, bytes, MREMAP_MAYMOVE);
+#else
+      p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+      if (p != MAP_FAILED) {
+        ::munmap(_map, _mappedBytes);
+      }
+#endif
+    } else {
+      p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    }
+    if (p == MAP_FAILED) {
+      int error{errno};
+      if (_map) {
+        [[maybe_unused]] int result{
+            ::ftruncate(_fd, static_cast<off_t>(_mappedBytes))};
+      }
+      errno = error;
+      fail("mmap");
+    }
+    _map = static_cast<std::byte*>(p);
+    _mappedBytes = bytes;
+    _space = (bytes - DATA_OFFSET) / sizeof(T);
+  }
+
+  // maps the file, checking the header of an existing one first so that a
+  // foreign file or one of another T is rejected before it is resized
+  void load(std::size_t capacity) {
+    struct stat info {};
+    if (::fstat(_fd, &info) != 0) {
+      fail("fstat");
+    }
+    std::size_t fileSize{static_cast<std::size_t>(info.st_size)};
+    if (fileSize == 0) {
+      map(bytes_for(capacity));
+      header() = Header{MAGIC, sizeof(T), 0};
+      return;
+    }
+    Header stored{};
+    if (fileSize < DATA_OFFSET ||
+        ::pread(_fd, &stored, sizeof(Header), 0) !=
+            static_cast<ssize_t>(sizeof(Header)) ||
+        stored._magic != MAGIC || stored._elementSize != sizeof(T) ||
+        stored._size > (fileSize - DATA_OFFSET) / sizeof(T)) {
+      errno = EINVAL;
+      fail("bad header in");
+    }
+    map(std::max(bytes_for(capacity), bytes_for((fileSize - DATA_OFFSET) /
+                                                sizeof(T))));
+  }
+
+  void reallocateIfRequired(std::size_t extra = 1) {
+    if (size() + extra > _space) {
+      map(bytes_for(GrowthPolicy::template next_capacity<void>(
+          _space, size() + extra)));
+    }
+  }
+
+  void close() noexcept {
+    if (_map) {
+      // drop the unused tail so the file holds exactly the data
+      std::size_t used{DATA_OFFSET + size() * sizeof(T)};
+      ::munmap(_map, _mappedBytes);
+      [[maybe_unused]] int result{
+          ::ftruncate(_fd, static_cast<off_t>(used))};
+      _map = nullptr;
+    }
+    if (_fd >= 0) {
+      ::close(_fd);
+      _fd = -1;
+    }
+  }
+
+public:
+  /* Constructors */
+  // opens path, creating it if missing. An existing file keeps its elements.
+  explicit MappedVector(std::string path, std::size_t capacity = 0)
+      : _path{std::move(path)} {
+    _fd = ::open(_path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (_fd < 0) {
+      fail("open");
+    }
+    try {
+      load(capacity);
+    } catch (...) {
+      // a throwing constructor runs no destructor
+      ::close(_fd);
+      throw;
+    }
+  }
+
+  ~MappedVector() { close(); }
+
+  MappedVector(const MappedVector&) = delete;
+  MappedVector& operator=(const MappedVector&) = delete;
+
+  MappedVector(MappedVector&& move) noexcept
+      : _path{std::move(move._path)}, _fd{std::exchange(move._fd, -1)},
+        _map{std::exchange(move._map, nullptr)},
+        _mappedBytes{std::exchange(move._mappedBytes, 0)},
+        _space{std::exchange(move._space, 0)} {}
+
+  MappedVector& operator=(MappedVector&& move) noexcept {
+    MappedVector tempMove{std::move(move)};
+    swap(tempMove);
+    return *this;
+  }
+
+  /* Iterators */
+  Iterator begin() { return elements(); };
+  Iterator end() { return elements() + size(); };
+  ConstIterator begin() const { return elements(); };
+  ConstIterator end() const { return elements() + size(); };
+  ConstIterator cbegin() const { return elements(); };
+  ConstIterator cend() const { return elements() + size(); };
+
+  /* Capacity */
+  bool empty() const { return size() == 0; };
+  std::size_t size() const {
+    return _map ? static_cast<std::size_t>(header()._size) : 0;
+  };
+  std::size_t capacity() const { return _space; };
+  const std::string& path() const { return _path; };
+
+  void reserve(std::size_t newCapacity) {
+    if (newCapacity > _space) {
+      map(bytes_for(newCapacity));
+    }
+  };
+
+  // new elements are copies of val
+  void resize(std::size_t newSize, const T& val = T()) {
+    reserve(newSize);
+    std::fill(elements() + std::min(size(), newSize), elements() + newSize,
+              val);
+    header()._size = newSize;
+  };
+
+  void shrink_to_fit() { map(bytes_for(size())); };
+
+  /* Modifiers */
+  void clear() { header()._size = 0; };
+
+  void push_back(const T& val) {
+    T copy{val};
+    reallocateIfRequired();
+    elements()[header()._size++] = copy;
+  };
+
+  template <typename... Args> void emplace_back(Args&&... args) {
+    push_back(T{std::forward<Args>(args)...});
+  }
+
+  value_type pop_back() { return elements()[--header()._size]; };
+
+  // reserves once for forward iterators
+  template <std::input_iterator Iter> void append(Iter first, Iter last) {
+    if constexpr (std::forward_iterator<Iter>) {
+      std::size_t count{static_cast<std::size_t>(std::distance(first, last))};
+      reallocateIfRequired(count);
+      std::copy(first, last, elements() + size());
+      header()._size += count;
+    } else {
+      for (; first != last; ++first) {
+        push_back(*first);
+      }
+    }
+  }
+
+  // appends count elements with whatever bytes the file holds there (zero for
+  // a fresh file) and returns a pointer to the first one
+  T* append_uninitialized(std::size_t count) {
+    reallocateIfRequired(count);
+    T* first{elements() + size()};
+    header()._size += count;
+    return first;
+  }
+
+  // write dirty pages back to the file now instead of whenever the kernel
+  // decides to
+  void sync() {
+    if (_map && ::msync(_map, _mappedBytes, MS_SYNC) != 0) {
+      fail("msync");
+    }
+  }
+
+  /* Element access */
+  T& operator[](std::size_t index) { return elements()[index]; };
+  const T& operator[](std::size_t index) const { return elements()[index]; };
+
+  T& at(std::size_t index) {
+    validateIndex(index);
+    return elements()[index];
+  };
+  const T& at(std::size_t index) const {
+    validateIndex(index);
+    return elements()[index];
+  };
+
+  T& front() { return elements()[0]; };
+  const T& front() const { return elements()[0]; };
+
+  T& back() { return elements()[size() - 1]; };
+  const T& back() const { return elements()[size() - 1]; };
+
+  T* data() { return elements(); };
+  const T* data() const { return elements(); };
+
+  void swap(MappedVector& other) noexcept {
+    using std::swap;
+    swap(_path, other._path);
+    swap(_fd, other._fd);
+    swap(_map, other._map);
+    swap(_mappedBytes, other._mappedBytes);
+    swap(_space, other._space);
+  }
+  friend void swap(MappedVector& a, MappedVector& b) noexcept { a.swap(b); }
+};
@@ -0,0 +1,401 @@
+#pragma once
+
+#include <algorithm>
+#include <allocator.hpp>
+#include <cmath>
+#include <concept.hpp>
+#include <contiguous-iterator.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <utility>
+
+#define SMALL_VECTOR_DEBUG 0
+
+#if SMALL_VECTOR_DEBUG == 1
+#define SMALL_VECTOR_DEBUG_MS(mes)                                             \
+  do {                                                                         \
+    helpers::printf(mes);                                                      \
+  } while (0)
+#else
+#define SMALL_VECTOR_DEBUG_MS(mes)                                             \
+  do {                                                                         \
+  } while (0)
+#endif
+
+// Vector with room for N elements inside the object itself. The heap is only
+// touched once the size grows past N, so short lists (adjacency lists, edge
+// lists, paths) cost no allocation at all. Same interface as Vector, a call
+// site can switch with a type alias.
+// Moving an inline SmallVector moves its elements one by one, only a spilled
+// one hands over its buffer.
+template <typename T, std::size_t N = 8,
+          concepts::Allocator Allocator = Allocator<T>>
+class SmallVector {
+  static_assert(N > 0, "use Vector for no inline storage");
+
+  inline static constexpr double growRate{1.5};
+
+public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using rvalue_reference = T&&;
+  using pointer = T*;
+  using Iterator = ContiguousIterator<T>;
+  using ConstIterator = ContiguousIterator<const T>;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+  using self = SmallVector<T, N, Allocator>;
+
+  class OutOfRangeException : public std::exception {
+    using std::exception::what;
+
+  private:
+    std::string message;
+
+  public:
+    OutOfRangeException(std::string msg) : message{msg} {}
+    std::string what() { return message; }
+  };
+
+private:
+  Allocator _allocator{};
+  std::size_t _size{};
+  std::size_t _space{N};
+  T* _elements{inline_elements()};
+  alignas(T) std::byte _inline[N * sizeof(T)];
+
+  T* inline_elements() noexcept { return reinterpret_cast<T*>(_inline); }
+
+  void validateIndex(std::size_t index) const {
+    if (_size > 0 && index >= _size) {
+      throw OutOfRangeException{"Index out of range"};
+    }
+  };
+
+  void reallocateIfRequired(std::size_t extra = 1) {
+    if (_size + extra <= _space) {
+      return;
+    }
+    reallocate(std::max(
+        _size + extra,
+        static_cast<std::size_t>(std::round(static_cast<double>(_space) *
+                                            growRate))));
+  }
+
+  // move every element to a buffer of the given capacity, back inline if it
+  // fits
+  void reallocate(std::size_t capacity) {
+    capacity = std::max(capacity, _size);
+    bool toInline{capacity <= N};
+    if (toInline && is_inline()) {
+      return;
+    }
+    T* newArr{toInline ? inline_elements() : _allocator.allocate(capacity)};
+    for (std::size_t i{}; i < _size; ++i) {
+      new (newArr + i) T{std::move(_elements[i])};
+      _elements[i].~T();
+    }
+    release_heap();
+    _elements = newArr;
+    _space = toInline ? N : capacity;
+  }
+
+  void release_heap() noexcept {
+    if (!is_inline()) {
+      _allocator.deallocate(_elements, _space);
+    }
+  }
+
+  // make room for count elements at index, the gap is left unconstructed
+  void open_gap(std::size_t index, std::size_t count) {
+    reallocateIfRequired(count);
+    for (std::size_t i{_size}; i > index; --i) {
+      new (_elements + i - 1 + count) T{std::move(_elements[i - 1])};
+      _elements[i - 1].~T();
+    }
+    _size += count;
+  }
+
+  // destroy count elements at index and close the gap
+  void close_gap(std::size_t index, std::size_t count) {
+    for (std::size_t i{index}; i < index + count; ++i) {
+      _elements[i].~T();
+    }
+    for (std::size_t i{index + count}; i < _size; ++i) {
+      new (_elements + i - count) T{std::move(_elements[i])};
+      _elements[i].~T();
+    }
+    _size -= count;
+  }
+
+  void validateInsertIndex(std::size_t index) const {
+    if (index > _size) {
+      throw OutOfRangeException{"Index out of range"};
+    }
+  }
+
+public:
+  /* Constructors */
+  SmallVector(std::size_t capacity = N) {
+    reserve(capacity);
+    SMALL_VECTOR_DEBUG_MS("SmallVector Ctor capacity");
+  };
+
+  SmallVector(std::size_t count, const_reference value) : SmallVector(count) {
+    for (std::size_t i{}; i < count; ++i) {
+      new (_elements + i) T{value};
+    }
+    _size = count;
+  };
+
+  SmallVector(std::initializer_list<T> list) : SmallVector(list.size()) {
+    SMALL_VECTOR_DEBUG_MS("SmallVector Ctor List");
+    for (const_reference ele : list) {
+      new (_elements + _size++) T{ele};
+    }
+  };
+
+  template <std::forward_iterator Iter>
+  SmallVector(Iter begin, Iter end)
+      : SmallVector(static_cast<std::size_t>(std::distance(begin, end))) {
+    SMALL_VECTOR_DEBUG_MS("SmallVector Iterator Ctor");
+    for (Iter i{begin}; i != end; ++i) {
+      new (_elements + _size++) T{*i};
+    }
+  }
+
+  ~SmallVector() {
+    SMALL_VECTOR_DEBUG_MS("SmallVector Dtor");
+    clear();
+    release_heap();
+  };
+
+  SmallVector(const self& copy) : SmallVector(copy._size) {
+    SMALL_VECTOR_DEBUG_MS("SmallVector Copy Ctor");
+    for (const_reference ele : copy) {
+      new (_elements + _size++) T{ele};
+    }
+  };
+
+  SmallVector(self&& move) noexcept : _allocator{std::move(move._allocator)} {
+    SMALL_VECTOR_DEBUG_MS("SmallVector Move Ctor");
+    steal(move);
+  };
+
+  // copy-and-swap
+  self& operator=(const self& copy) {
+    SMALL_VECTOR_DEBUG_MS("SmallVector copy assign");
+    self tempCopy{copy};
+    tempCopy.swap(*this);
+    return *this;
+  };
+
+  self& operator=(self&& move) noexcept {
+    SMALL_VECTOR_DEBUG_MS("SmallVector move assign");
+    if (this != &move) {
+      clear();
+      release_heap();
+      _elements = inline_elements();
+      _space = N;
+      steal(move);
+    }
+    return *this;
+  };
+
+  /* Iterators */
+  Iterator begin() { return _elements; };
+  Iterator end() { return _elements + _size; };
+  ConstIterator begin() const { return _elements; };
+  ConstIterator end() const { return _elements + _size; };
+  ConstIterator cbegin() const { return _elements; };
+  ConstIterator cend() const { return _elements + _size; };
+
+  /* Capacity */
+  bool empty() const { return _size == 0; };
+  std::size_t capacity() const { return _space; };
+  std::size_t size() const { return _size; };
+  // elements still live in the object itself
+  bool is_inline() const {
+    return _elements == reinterpret_cast<const T*>(_inline);
+  };
+  static constexpr std::size_t inline_capacity() { return N; };
+
+  // reserve() will never decrease the capacity.
+  void reserve(std::size_t newCapacity) {
+    if (newCapacity > _space) {
+      reallocate(newCapacity);
+    }
+  };
+
+  void resize(std::size_t newSize, const T& val = T()) {
+    if (newSize < _size) {
+      close_gap(newSize, _size - newSize);
+      return;
+    }
+    reserve(newSize);
+    for (std::size_t i{_size}; i < newSize; ++i) {
+      new (_elements + i) T{val};
+    }
+    _size = newSize;
+  };
+
+  // moves the elements back inline when they fit
+  void shrink_to_fit() { reallocate(_size); };
+
+  /* Modifiers */
+  // Capacity is not changed.
+  void clear() {
+    for (std::size_t i{}; i < _size; ++i) {
+      _elements[i].~T();
+    }
+    _size = 0;
+  };
+
+  void push_back(T&& val) { emplace_back(std::move(val)); };
+  void push_back(const T& val) { emplace_back(val); };
+
+  value_type pop_back() {
+    T ele{std::move(_elements[--_size])};
+    _elements[_size].~T();
+    return ele;
+  };
+
+  template <typename... Args> void emplace_back(Args&&... args) {
+    if (_size == _space) {
+      // args may alias an element, build the new one before moving them
+      T ele{std::forward<Args>(args)...};
+      reallocateIfRequired();
+      new (_elements + _size) T{std::move(ele)};
+    } else {
+      new (_elements + _size) T{std::forward<Args>(args)...};
+    }
+    ++_size;
+  }
+
+  void insert(std::size_t insertIndex, const T& ele) {
+    validateInsertIndex(insertIndex);
+    T copy{ele};
+    open_gap(insertIndex, 1);
+    new (_elements + insertIndex) T{std::move(copy)};
+  };
+
+  void insert(std::size_t insertIndex, T&& ele) {
+    validateInsertIndex(insertIndex);
+    T moved{std::move(ele)};
+    open_gap(insertIndex, 1);
+    new (_elements + insertIndex) T{std::move(moved)};
+  };
+
+  template <typename... Args>
+    requires(sizeof...(Args) > 0)
+  void insert(std::size_t insertIndex, Args&&... args) {
+    validateInsertIndex(insertIndex);
+    // args may alias elements that open_gap shifts or frees, copy them first
+    T copies[]{T{std::forward<Args>(args)}...};
+    open_gap(insertIndex, sizeof...(args));
+    for (T& copy : copies) {
+      new (_elements + (insertIndex++)) T{std::move(copy)};
+    }
+  }
+
+  template <std::forward_iterator Input>
+  void insert(std::size_t insertIndex, Input first, Input last) {
+    validateInsertIndex(insertIndex);
+    open_gap(insertIndex,
+             static_cast<std::size_t>(std::distance(first, last)));
+    for (Input i{first}; i != last; ++i) {
+      new (_elements + (insertIndex++)) T{*i};
+    }
+  }
+
+  void erase(std::size_t index) {
+    validateIndex(index);
+    close_gap(index, 1);
+  };
+
+  void erase(Iterator iter) {
+    erase(static_cast<std::size_t>(iter - begin()));
+  };
+
+  // erases [startIndex, endIndex], both ends included as in Vector
+  void erase(std::size_t startIndex, std::size_t endIndex) {
+    validateIndex(startIndex);
+    validateIndex(endIndex);
+    close_gap(startIndex, endIndex - startIndex + 1);
+  };
+
+  void reverse() { std::reverse(begin(), end()); };
+
+  /* Element access */
+  T& operator[](std::size_t index) { return _elements[index]; };
+  const T& operator[](std::size_t index) const { return _elements[index]; };
+
+  T& at(std::size_t index) {
+    validateIndex(index);
+    return _elements[index];
+  };
+
+  const T& at(std::size_t index) const {
+    validateIndex(index);
+    return _elements[index];
+  };
+
+  T& front() { return _elements[0]; };
+  const T& front() const { return _elements[0]; };
+
+  T& back() { return _elements[_size - 1]; };
+  const T& back() const { return _elements[_size - 1]; };
+
+  T* data() { return _elements; };
+  const T* data() const { return _elements; };
+
+  void swap(self& other) noexcept {
+    if (!is_inline() && !other.is_inline()) {
+      using std::swap;
+      swap(_allocator, other._allocator);
+      swap(_size, other._size);
+      swap(_space, other._space);
+      swap(_elements, other._elements);
+      return;
+    }
+    self tmp{std::move(other)};
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+  friend void swap(self& a, self& b) noexcept { a.swap(b); }
+
+  friend std::ostream& operator<<(std::ostream& stream, const self& vector) {
+    auto el{vector.cbegin()};
+    stream << "[";
+    if (el != vector.cend()) {
+      stream << *el;
+      for (++el; el != vector.cend(); ++el)
+        stream << ", " << *el;
+    }
+    stream << "]";
+    return stream;
+  }
+
+private:
+  // take over other's elements, leaving it empty and inline
+  void steal(self& other) noexcept {
+    if (other.is_inline()) {
+      for (std::size_t i{}; i < other._size; ++i) {
+        new (_elements + i) T{std::move(other._elements[i])};
+        other._elements[i].~T();
+      }
+    } else {
+      _elements = other._elements;
+      _space = other._space;
+      other._elements = other.inline_elements();
+      other._space = N;
+    }
+    _size = other._size;
+    other._size = 0;
+  }
+};
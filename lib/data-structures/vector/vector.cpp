@@ -2,6 +2,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <helpers.hpp>
 #include <initializer_list>
 #include <iostream>
@@ -28,15 +29,16 @@ using std::endl;
   } while (0)
 #endif
 
-template <typename T>
-Vector<T>::Vector(std::size_t capacity)
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(std::size_t capacity)
     : _size{0}, _space{capacity},
-      _elements{static_cast<T*>(::operator new(sizeof(T) * capacity))} {
+      _elements{_allocator.allocate(capacity)} {
   VECTOR_DEBUG_MS("Vector Ctor capacity");
 }
 
-template <typename T>
-Vector<T>::Vector(std::size_t capacity, const T& value) : Vector(capacity) {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(std::size_t capacity, const T& value)
+    : Vector(capacity) {
   _size = capacity;
 
   for (std::size_t index{}; index < _size; ++index) {
@@ -44,8 +46,9 @@ Vector<T>::Vector(std::size_t capacity, const T& value) : Vector(capacity) {
   }
 };
 
-template <typename T>
-Vector<T>::Vector(std::initializer_list<T> list) : Vector(list.size() + 2) {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(std::initializer_list<T> list)
+    : Vector(list.size() + 2) {
   VECTOR_DEBUG_MS("Vector Ctor List");
 
   for (std::size_t index{}; index < list.size(); ++index) {
@@ -54,36 +57,35 @@ Vector<T>::Vector(std::initializer_list<T> list) : Vector(list.size() + 2) {
   _size = list.size();
 }
 
-template <typename T>
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
 template <std::random_access_iterator Iter>
-Vector<T>::Vector(Iter begin, Iter end)
+Vector<T, Allocator, GrowthPolicy>::Vector(Iter begin, Iter end)
     : Vector(static_cast<std::size_t>(end - begin)) {
   VECTOR_DEBUG_MS("Vector Iterator Ctor");
-  for (auto i{begin}; i != end; ++i) {
-    push_back(*i);
-  }
+  append(begin, end);
 }
 
-template <typename T>
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
 template <std::forward_iterator Iter>
-Vector<T>::Vector(Iter begin, Iter end) : Vector(5) {
+Vector<T, Allocator, GrowthPolicy>::Vector(Iter begin, Iter end) : Vector(5) {
   VECTOR_DEBUG_MS("Vector Iterator Ctor");
   for (auto i{begin}; i != end; ++i) {
     push_back(*i);
   }
 }
 
-template <typename T> Vector<T>::~Vector() {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::~Vector() {
   VECTOR_DEBUG_MS("Vector Dtor");
 
   clear();
-  ::operator delete(_elements);
+  _allocator.deallocate(_elements, _space);
 }
 
-template <typename T>
-Vector<T>::Vector(const Vector<T>& copy)
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(const Vector& copy)
     : _size{copy._size}, _space{copy._space},
-      _elements{static_cast<T*>(::operator new(sizeof(T) * copy._space))} {
+      _elements{_allocator.allocate(copy._space)} {
   VECTOR_DEBUG_MS("Vector Copy Ctor");
 
   for (std::size_t index{}; index < _size; ++index) {
@@ -93,16 +95,18 @@ Vector<T>::Vector(const Vector<T>& copy)
 
 // copy-and-swap and move-and-swap idiom
 // inefficient, need testing
-template <typename T> Vector<T>& Vector<T>::operator=(const Vector<T>& copy) {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>&
+Vector<T, Allocator, GrowthPolicy>::operator=(const Vector& copy) {
   VECTOR_DEBUG_MS("Vector copy assign capacity");
 
-  Vector<T> tempCopy{copy};
+  Vector<T, Allocator, GrowthPolicy> tempCopy{copy};
   tempCopy.swap(*this);
   return *this;
 }
 
-template <typename T>
-Vector<T>::Vector(Vector<T>&& move) noexcept
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>::Vector(Vector&& move) noexcept
     : _size{move._size}, _space{move._space}, _elements{move._elements} {
   VECTOR_DEBUG_MS("Vector Move Ctor");
 
@@ -111,17 +115,19 @@ Vector<T>::Vector(Vector<T>&& move) noexcept
   move._elements = nullptr;
 }
 
-template <typename T>
-Vector<T>& Vector<T>::operator=(Vector<T>&& move) noexcept {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+Vector<T, Allocator, GrowthPolicy>&
+Vector<T, Allocator, GrowthPolicy>::operator=(Vector&& move) noexcept {
   VECTOR_DEBUG_MS("Vector Move assignment capacity");
 
-  Vector<T> tempMove{std::move(move)};
+  Vector<T, Allocator, GrowthPolicy> tempMove{std::move(move)};
   tempMove.swap(*this);
   return *this;
 }
 
 /* Iterator */
-template <typename T> class Vector<T>::Iterator {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+class Vector<T, Allocator, GrowthPolicy>::Iterator {
 public:
   using iterator_category = std::contiguous_iterator_tag;
   using difference_type = std::ptrdiff_t;
@@ -216,33 +222,41 @@ public:
   reference operator[](difference_type index) const { return _current[index]; }
 };
 
-template <typename T> typename Vector<T>::Iterator Vector<T>::begin() {
-  return Vector<T>::Iterator{&_elements[0]};
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+typename Vector<T, Allocator, GrowthPolicy>::Iterator
+Vector<T, Allocator, GrowthPolicy>::begin() {
+  return Vector<T, Allocator, GrowthPolicy>::Iterator{&_elements[0]};
 }
 
-template <typename T>
-const typename Vector<T>::Iterator Vector<T>::cbegin() const {
-  return Vector<T>::Iterator{&_elements[0]};
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+const typename Vector<T, Allocator, GrowthPolicy>::Iterator
+Vector<T, Allocator, GrowthPolicy>::cbegin() const {
+  return Vector<T, Allocator, GrowthPolicy>::Iterator{&_elements[0]};
 }
 
-template <typename T> typename Vector<T>::Iterator Vector<T>::end() {
-  return Vector<T>::Iterator{&_elements[_size]};
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+typename Vector<T, Allocator, GrowthPolicy>::Iterator
+Vector<T, Allocator, GrowthPolicy>::end() {
+  return Vector<T, Allocator, GrowthPolicy>::Iterator{&_elements[_size]};
 }
 
-template <typename T>
-const typename Vector<T>::Iterator Vector<T>::cend() const {
-  return Vector<T>::Iterator{&_elements[_size]};
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+const typename Vector<T, Allocator, GrowthPolicy>::Iterator
+Vector<T, Allocator, GrowthPolicy>::cend() const {
+  return Vector<T, Allocator, GrowthPolicy>::Iterator{&_elements[_size]};
 }
 
 /* Capacity */
-template <typename T> void Vector<T>::reserve(std::size_t newCapacity) {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::reserve(std::size_t newCapacity) {
   if (newCapacity > _space) {
     reallocate(newCapacity);
   }
 }
 
-template <typename T>
-void Vector<T>::resize(std::size_t newsize, const T& val) {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::resize(std::size_t newsize,
+                                                const T& val) {
   if (_size > newsize) {
     for (std::size_t index = newsize; index < _size; ++index) {
       _elements[index].~T();
@@ -257,159 +271,207 @@ void Vector<T>::resize(std::size_t newsize, const T& val) {
   _size = newsize;
 }
 
-template <typename T> void Vector<T>::shrink_to_fit() { reallocate(_size); }
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::shrink_to_fit() {
+  reallocate(_size);
+}
 
 /* Modifiers */
-template <typename T> void Vector<T>::clear() {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::clear() {
   while (_size) {
     pop_back();
   }
 }
-template <typename T> void Vector<T>::push_back(T&& val) {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::push_back(T&& val) {
   reallocateIfRequired();
   new (_elements + _size) T{std::move(val)};
   ++_size;
 }
 
-template <typename T> void Vector<T>::push_back(const T& val) {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::push_back(const T& val) {
   reallocateIfRequired();
   new (_elements + _size) T{val};
   ++_size;
 }
-template <typename T> void Vector<T>::reallocateIfRequired() {
-  if (_size < _space)
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::reallocateIfRequired(
+    std::size_t extra) {
+  if (_size + extra <= _space)
     return;
-  std::size_t newCapacity{
-      static_cast<std::size_t>(std::max(2.0, std::round(_space * growRate)))};
-  reallocate(newCapacity);
+  reallocate(GrowthPolicy::template next_capacity<Allocator>(_space,
+                                                            _size + extra));
 }
-template <typename T> void Vector<T>::reallocate(std::size_t capacity) {
-  T* newArr{static_cast<T*>(::operator new(sizeof(T) * capacity))};
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::reallocate(std::size_t capacity) {
+  T* newArr{_allocator.allocate(capacity)};
 
-  for (std::size_t i = 0; i < _size; ++i) {
-    new (newArr + i) T{std::move(_elements[i])};
+  if constexpr (isTriviallyRelocatable) {
+    if (_size) {
+      std::memcpy(static_cast<void*>(newArr), _elements, _size * sizeof(T));
+    }
+  } else {
+    for (std::size_t i = 0; i < _size; ++i) {
+      new (newArr + i) T{std::move(_elements[i])};
+      _elements[i].~T();
+    }
   }
 
-  _space = capacity;
   std::swap(_elements, newArr);
+  _allocator.deallocate(newArr, _space);
+  _space = capacity;
+}
+
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::shiftRight(std::size_t index,
+                                                    std::size_t count) {
+  if constexpr (isTriviallyRelocatable) {
+    if (index < _size) {
+      std::memmove(static_cast<void*>(_elements + index + count),
+                   _elements + index, (_size - index) * sizeof(T));
+    }
+  } else {
+    for (std::size_t i{_size}; i > index; --i) {
+      new (_elements + i - 1 + count) T{std::move(_elements[i - 1])};
+      _elements[i - 1].~T();
+    }
+  }
+}
 
-  ::operator delete(newArr);
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::shiftLeft(std::size_t index,
+                                                   std::size_t count) {
+  if constexpr (isTriviallyRelocatable) {
+    std::size_t tail{_size - std::min(_size, index + count)};
+    if (tail) {
+      std::memmove(static_cast<void*>(_elements + index),
+                   _elements + index + count, tail * sizeof(T));
+    }
+  } else {
+    for (std::size_t i{index + count}; i < _size; ++i) {
+      new (_elements + i - count) T{std::move(_elements[i])};
+      _elements[i].~T();
+    }
+  }
 }
-template <typename T> T Vector<T>::pop_back() {
+
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+T Vector<T, Allocator, GrowthPolicy>::pop_back() {
   T ele{std::move(_elements[--_size])};
   return ele;
 }
 
-template <typename T>
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
 template <typename... Args>
-void Vector<T>::emplace_back(Args&&... args) {
+void Vector<T, Allocator, GrowthPolicy>::emplace_back(Args&&... args) {
   reallocateIfRequired();
   new (_elements + _size) T{std::forward<Args>(args)...};
   ++_size;
 }
 
-template <typename T> void Vector<T>::erase(std::size_t index) {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::erase(std::size_t index) {
   validateIndex(index);
   _elements[index].~T();
-  for (std::size_t i{index}; i < _size - 1; ++i) {
-    new (_elements + i) T{std::move(_elements[i + 1])};
-  }
+  shiftLeft(index, 1);
   --_size;
 }
 
-template <typename T> void Vector<T>::erase(Iterator iter) {
-  std::size_t index{(std::size_t)std::distance(begin(), iter)};
-  validateIndex(index);
-  _elements[index].~T();
-  for (std::size_t i{index}; i < _size - 1; ++i) {
-    new (_elements + i) T{std::move(_elements[i + 1])};
-  }
-  --_size;
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::erase(Iterator iter) {
+  erase(static_cast<std::size_t>(std::distance(begin(), iter)));
 }
 
-template <typename T>
-void Vector<T>::erase(std::size_t startIndex, std::size_t endIndex) {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::erase(std::size_t startIndex,
+                                               std::size_t endIndex) {
   validateIndex(startIndex);
   validateIndex(endIndex);
   std::size_t distance{endIndex - startIndex + 1};
   for (std::size_t i{startIndex}; i <= endIndex; ++i) {
     _elements[i].~T();
   }
-  for (std::size_t i{endIndex + 1}; i < _size; ++i) {
-    new (_elements + i - distance) T{std::move(_elements[i])};
-  }
+  shiftLeft(startIndex, distance);
   _size -= distance;
 }
 
-template <typename T>
-void Vector<T>::insert(std::size_t insertIndex, const T& ele) {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::insert(std::size_t insertIndex,
+                                                const T& ele) {
   validateIndex(insertIndex);
   reallocateIfRequired();
-  ++_size;
-  if (_size > 0) {
-    for (std::size_t i{_size - 1}; i > insertIndex; --i) {
-      new (_elements + i) T{std::move(_elements[i - 1])};
-      _elements[i - 1].~T();
-    }
-  }
+  shiftRight(insertIndex, 1);
   new (_elements + insertIndex) T{ele};
+  ++_size;
 }
-template <typename T> void Vector<T>::insert(std::size_t insertIndex, T&& ele) {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::insert(std::size_t insertIndex,
+                                                T&& ele) {
   validateIndex(insertIndex);
   reallocateIfRequired();
-  ++_size;
-  if (_size > 0) {
-    for (std::size_t i{_size - 1}; i > insertIndex; --i) {
-      new (_elements + i) T{std::move(_elements[i - 1])};
-      _elements[i - 1].~T();
-    }
-  }
-
+  shiftRight(insertIndex, 1);
   new (_elements + insertIndex) T{std::move(ele)};
+  ++_size;
 }
 
-template <typename T>
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
 template <typename... Args>
-void Vector<T>::insert(std::size_t insertIndex, Args&&... args) {
+void Vector<T, Allocator, GrowthPolicy>::insert(std::size_t insertIndex,
+                                                Args&&... args) {
   validateIndex(insertIndex);
-  constexpr int eleNum = sizeof...(args);
-  std::size_t oldSize{_size};
+  constexpr std::size_t eleNum{sizeof...(args)};
+  reallocateIfRequired(eleNum);
+  shiftRight(insertIndex, eleNum);
   _size += eleNum;
-  if (_size > _space) {
-    reallocate(_size * growRate);
-  }
-  if (oldSize != 0) {
-    for (std::size_t i{oldSize - 1}; i >= insertIndex; --i) {
-      new (_elements + i + eleNum) T{std::move(_elements[i])};
-      _elements[i].~T();
-    }
-  }
 
-  ((new (_elements + (insertIndex++)) T{std::forward<T>(args)}), ...);
+  ((new (_elements + (insertIndex++)) T{std::forward<Args>(args)}), ...);
 }
 
-template <typename T>
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
 template <concepts::IsIterator Input>
-void Vector<T>::insert(std::size_t insertIndex, Input first, Input last) {
+void Vector<T, Allocator, GrowthPolicy>::insert(std::size_t insertIndex,
+                                                Input first, Input last) {
   validateIndex(insertIndex);
   std::size_t eleNum{static_cast<std::size_t>(last - first)};
-  std::size_t oldSize{_size};
+  reallocateIfRequired(eleNum);
+  shiftRight(insertIndex, eleNum);
   _size += eleNum;
-  if (_size > _space) {
-    reallocate(_size * growRate);
+  for (auto index = first; index != last; ++index) {
+    new (_elements + (insertIndex++)) T{*index};
   }
-  if (oldSize != 0) {
-    for (std::size_t i{oldSize - 1}; i >= insertIndex; --i) {
-      new (_elements + i + eleNum) T{std::move(_elements[i])};
-      _elements[i].~T();
+}
+
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+template <std::input_iterator Iter>
+void Vector<T, Allocator, GrowthPolicy>::append(Iter first, Iter last) {
+  if constexpr (std::forward_iterator<Iter>) {
+    reallocateIfRequired(static_cast<std::size_t>(std::distance(first, last)));
+    for (; first != last; ++first) {
+      new (_elements + _size) T{*first};
+      ++_size;
+    }
+  } else {
+    for (; first != last; ++first) {
+      push_back(*first);
     }
   }
-  for (auto index = first; index != last; ++index) {
-    new (_elements + (insertIndex++)) T{*index};
+}
+
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+T* Vector<T, Allocator, GrowthPolicy>::append_uninitialized(std::size_t count) {
+  reallocateIfRequired(count);
+  T* first{_elements + _size};
+  for (std::size_t i{}; i < count; ++i) {
+    new (first + i) T;
   }
+  _size += count;
+  return first;
 }
 
-template <typename T> void Vector<T>::reverse() {
+template <typename T, concepts::Allocator Allocator, typename GrowthPolicy>
+void Vector<T, Allocator, GrowthPolicy>::reverse() {
   using std::swap;
   for (std::size_t i{}, j{size() - 1}; i < j; ++i, --j) {
     swap(_elements[i], _elements[j]);
@@ -1,15 +1,19 @@
 #pragma once
 
+#include <allocator.hpp>
 #include <concept.hpp>
 #include <cstddef>
+#include <growth-policy.hpp>
 #include <initializer_list>
 #include <iostream>
+#include <iterator>
 #include <string>
+#include <type_traits>
 #include <utility>
 
-template <typename T> class Vector {
-  inline static constexpr double growRate{1.5};
-
+template <typename T, concepts::Allocator Allocator = Allocator<T>,
+          typename GrowthPolicy = GrowHalf>
+class Vector {
 public:
   using value_type = T;
   using reference = T&;
@@ -27,12 +31,27 @@ public:
   };
 
 private:
+  // stateless allocators take no space
+  [[no_unique_address]] Allocator _allocator{};
   std::size_t _size{};
   std::size_t _space{};
   T* _elements{};
 
-  void reallocateIfRequired();
+  // ints, PODs, pairs of them... can be moved around with memcpy/memmove
+  // instead of a move-construct and destroy per element
+  inline static constexpr bool isTriviallyRelocatable{
+      std::is_trivially_move_constructible_v<T> &&
+      std::is_trivially_destructible_v<T>};
+
+  // grow through GrowthPolicy if extra more elements do not fit
+  void reallocateIfRequired(std::size_t extra = 1);
   void reallocate(std::size_t capacity);
+  // move [index, _size) count slots to the right, capacity must allow it.
+  // _size is left unchanged.
+  void shiftRight(std::size_t index, std::size_t count);
+  // move [index + count, _size) count slots to the left, over elements that
+  // have already been destroyed. _size is left unchanged.
+  void shiftLeft(std::size_t index, std::size_t count);
   void validateIndex(std::size_t index) const {
     if (_size > 0 && index >= _size) {
       throw OutOfRangeException{"Index out of range"};
@@ -52,11 +71,11 @@ public:
   template <std::forward_iterator Iter> Vector(Iter begin, Iter end);
   ~Vector();
 
-  Vector(const Vector<T>& copy);
-  Vector<T>& operator=(const Vector<T>& copy);
+  Vector(const Vector& copy);
+  Vector& operator=(const Vector& copy);
 
-  Vector(Vector<T>&& move) noexcept;
-  Vector<T>& operator=(Vector<T>&& move) noexcept;
+  Vector(Vector&& move) noexcept;
+  Vector& operator=(Vector&& move) noexcept;
 
   /* Iterators */
   class Iterator;
@@ -101,6 +120,13 @@ public:
   void erase(Iterator iter);
   void erase(std::size_t startIndex, std::size_t endIndex);
 
+  // Bulk append, reserves once for forward iterators and constructs in place
+  template <std::input_iterator Iter> void append(Iter first, Iter last);
+  // Appends count default-initialized elements (left indeterminate for
+  // trivial types) and returns a pointer to the first one, to be filled in
+  // place, e.g. by a read() call.
+  T* append_uninitialized(std::size_t count);
+
   void reverse();
 
   /* Element access */
@@ -126,13 +152,14 @@ public:
   T* data() { return _elements; };
   const T* data() const { return _elements; };
 
-  void swap(Vector<T>& other) noexcept {
+  void swap(Vector& other) noexcept {
     using std::swap;
     swap(_size, other._size);
     swap(_space, other._space);
     swap(_elements, other._elements);
+    swap(_allocator, other._allocator);
   }
-  friend void swap(Vector<T>& a, Vector<T>& b) noexcept { a.swap(b); }
+  friend void swap(Vector& a, Vector& b) noexcept { a.swap(b); }
 
   friend std::ostream& operator<<(std::ostream& stream, const Vector& vector) {
     auto el{vector.cbegin()};
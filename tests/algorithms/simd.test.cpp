@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <array.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <limits>
+#include <simd.hpp>
+#include <static-circular-buffer.hpp>
+#include <string>
+#include <timer.hpp>
+#include <vector.hpp>
+
+// every length up to a few vectors, at every offset from an aligned start,
+// against the standard algorithms
+template <typename T> void matchesStd() {
+  constexpr std::size_t maxLength{100};
+  Vector<T> values(maxLength + 8);
+  for (std::size_t i{}; i < maxLength + 8; ++i) {
+    values.push_back(static_cast<T>((i * 37 + 11) % 23));
+  }
+  for (std::size_t offset{}; offset < 8; ++offset) {
+    const T* first{values.data() + offset};
+    for (std::size_t length{}; length <= maxLength; ++length) {
+      const T* last{first + length};
+      for (T needle : {T{0}, T{11}, T{22}, T{99}}) {
+        EXPECT_EQ(algorithms::simd::find(first, length, needle),
+                  static_cast<std::size_t>(std::find(first, last, needle) -
+                                           first));
+        EXPECT_EQ(algorithms::simd::count(first, length, needle),
+                  static_cast<std::size_t>(std::count(first, last, needle)));
+      }
+      if (length > 0) {
+        EXPECT_EQ(algorithms::simd::min_element(first, length),
+                  static_cast<std::size_t>(std::min_element(first, last) -
+                                           first));
+        EXPECT_EQ(algorithms::simd::max_element(first, length),
+                  static_cast<std::size_t>(std::max_element(first, last) -
+                                           first));
+      }
+    }
+  }
+  Vector<T> filled(maxLength);
+  for (std::size_t i{}; i < maxLength; ++i) {
+    filled.push_back(T{1});
+  }
+  algorithms::simd::fill(filled.data() + 3, maxLength - 5, T{7});
+  for (std::size_t i{}; i < maxLength; ++i) {
+    EXPECT_EQ(filled[i], i < 3 || i >= maxLength - 2 ? T{1} : T{7});
+  }
+}
+
+TEST(SimdTest, MatchesStd) {
+  matchesStd<std::int8_t>();
+  matchesStd<std::uint16_t>();
+  matchesStd<int>();
+  matchesStd<std::uint64_t>();
+  matchesStd<float>();
+  matchesStd<double>();
+}
+
+TEST(SimdTest, CountDoesNotOverflowNarrowLanes) {
+  constexpr std::size_t length{100'003};
+  Vector<std::int8_t> values(length);
+  for (std::size_t i{}; i < length; ++i) {
+    values.push_back(5);
+  }
+  EXPECT_EQ(algorithms::simd::count(values.data(), length, std::int8_t{5}),
+            length);
+}
+
+TEST(SimdTest, OtherTypesTakeTheScalarPath) {
+  std::string words[]{"b", "a", "c", "a"};
+  EXPECT_EQ(algorithms::simd::find(words, 4, std::string{"c"}), 2);
+  EXPECT_EQ(algorithms::simd::count(words, 4, std::string{"a"}), 2);
+  EXPECT_EQ(algorithms::simd::min_element(words, 4), 1);
+  EXPECT_EQ(algorithms::simd::max_element(words, 4), 2);
+}
+
+TEST(SimdTest, Array) {
+  Array<int, 40> array{};
+  array.fill(3);
+  EXPECT_EQ(array.count(3), 40);
+  array[17] = -1;
+  array[30] = 9;
+  array[35] = -1;
+  EXPECT_EQ(array.find(-1), 17);
+  EXPECT_EQ(array.find(5), 40);
+  EXPECT_EQ(array.count(-1), 2);
+  EXPECT_EQ(array.min_element(), 17);
+  EXPECT_EQ(array.max_element(), 30);
+}
+
+// a NaN may win or lose, but the index has to point into the range
+TEST(SimdTest, NaNGivesAValidIndex) {
+  constexpr float nan{std::numeric_limits<float>::quiet_NaN()};
+  Array<float, 8> array{nan, 5, 3, 4, 1, 7, 8, 9};
+  EXPECT_LT(array.min_element(), 8);
+  EXPECT_LT(array.max_element(), 8);
+
+  Vector<double> values(40);
+  for (std::size_t i{}; i < 40; ++i) {
+    values.push_back(static_cast<double>(i % 7));
+  }
+  for (std::size_t length{1}; length <= 40; ++length) {
+    for (std::size_t at{}; at < length; ++at) {
+      values[at] = std::numeric_limits<double>::quiet_NaN();
+      EXPECT_LT(algorithms::simd::min_element(values.data(), length), length);
+      EXPECT_LT(algorithms::simd::max_element(values.data(), length), length);
+      values[at] = static_cast<double>(at % 7);
+    }
+  }
+
+  // NaN in the run before the wrap
+  StaticCircularBuffer<float, 16> buffer{};
+  for (int i{}; i < 12; ++i) {
+    buffer.push_back(0);
+    buffer.pop_front();
+  }
+  buffer.push_back(nan);
+  for (int i{}; i < 10; ++i) {
+    buffer.push_back(static_cast<float>(i));
+  }
+  EXPECT_LT(buffer.min_element(), buffer.size());
+  EXPECT_LT(buffer.max_element(), buffer.size());
+}
+
+TEST(SimdTest, StaticCircularBufferAcrossTheWrap) {
+  constexpr std::size_t capacity{50};
+  for (std::size_t shift{}; shift < capacity; ++shift) {
+    StaticCircularBuffer<int, capacity> buffer{};
+    for (std::size_t i{}; i < shift; ++i) {
+      buffer.push_back(0);
+      buffer.pop_front();
+    }
+    for (int i{}; i < 45; ++i) {
+      buffer.push_back((i * 29 + 3) % 17);
+    }
+    auto index = [&](auto iter) {
+      return static_cast<std::size_t>(iter - buffer.begin());
+    };
+    for (int needle : {0, 3, 16, 40}) {
+      EXPECT_EQ(buffer.find(needle),
+                index(std::find(buffer.begin(), buffer.end(), needle)));
+      EXPECT_EQ(buffer.count(needle),
+                static_cast<std::size_t>(
+                    std::count(buffer.begin(), buffer.end(), needle)));
+    }
+    EXPECT_EQ(buffer.min_element(),
+              index(std::min_element(buffer.begin(), buffer.end())));
+    EXPECT_EQ(buffer.max_element(),
+              index(std::max_element(buffer.begin(), buffer.end())));
+
+    buffer.fill(8);
+    EXPECT_EQ(buffer.size(), 45);
+    EXPECT_EQ(buffer.count(8), 45);
+    // the free slots are untouched
+    buffer.push_back(1);
+    EXPECT_EQ(buffer.find(1), 45);
+  }
+}
+
+// the buffer wrapped halfway, searched for a value it does not hold, so
+// every element is visited
+template <std::size_t N> void searchBenchmark() {
+  constexpr std::size_t rounds{2'000'000 / N + 1};
+  StaticCircularBuffer<int, N> buffer{};
+  for (std::size_t i{}; i < N / 2; ++i) {
+    buffer.push_back(0);
+    buffer.pop_front();
+  }
+  for (std::size_t i{}; i < N; ++i) {
+    buffer.push_back(static_cast<int>(i));
+  }
+
+  std::size_t found{};
+  Timer timer{};
+  for (std::size_t round{}; round < rounds; ++round) {
+    int needle{-static_cast<int>(round)};
+    found += static_cast<std::size_t>(
+        std::find(buffer.begin(), buffer.end(), needle) - buffer.begin());
+  }
+  double iteratorTime{timer.elapsed()};
+
+  std::size_t simdFound{};
+  timer.reset();
+  for (std::size_t round{}; round < rounds; ++round) {
+    simdFound += buffer.find(-static_cast<int>(round));
+  }
+  double simdTime{timer.elapsed()};
+  EXPECT_EQ(found, simdFound);
+
+  long long minimum{};
+  timer.reset();
+  for (std::size_t round{}; round < rounds; ++round) {
+    minimum += *std::min_element(buffer.begin(), buffer.end());
+    buffer.back() = static_cast<int>(round);
+  }
+  double iteratorMinTime{timer.elapsed()};
+
+  long long simdMinimum{};
+  timer.reset();
+  for (std::size_t round{}; round < rounds; ++round) {
+    simdMinimum += buffer[buffer.min_element()];
+    buffer.back() = static_cast<int>(round);
+  }
+  double simdMinTime{timer.elapsed()};
+  EXPECT_EQ(minimum, simdMinimum);
+
+  double perRound{1e9 / static_cast<double>(rounds)};
+  std::cout << "N = " << N << ": FIND ITERATOR " << iteratorTime * perRound
+            << " ns, SIMD " << simdTime * perRound
+            << " ns; MIN_ELEMENT ITERATOR " << iteratorMinTime * perRound
+            << " ns, SIMD " << simdMinTime * perRound << " ns\n";
+}
+
+TEST(PerfTest, SimdSearch) {
+  std::cout << "VECTOR BYTES " << algorithms::simd::VECTOR_BYTES << '\n';
+  searchBenchmark<16>();
+  searchBenchmark<32>();
+  searchBenchmark<64>();
+  searchBenchmark<128>();
+  searchBenchmark<256>();
+  searchBenchmark<512>();
+  searchBenchmark<1024>();
+}
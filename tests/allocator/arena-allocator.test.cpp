@@ -0,0 +1,110 @@
+#include <adjacency-list.hpp>
+#include <arena-allocator.hpp>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <helpers.hpp>
+#include <iostream>
+#include <timer.hpp>
+#include <tree.hpp>
+
+static_assert(concepts::Allocator<ArenaAllocator<int>>);
+static_assert(concepts::MonotonicAllocator<ArenaAllocator<int>>);
+static_assert(!concepts::MonotonicAllocator<Allocator<int>>);
+
+TEST(MonotonicArenaTest, BumpAllocation) {
+  MonotonicArena arena{256};
+  char* c{static_cast<char*>(arena.allocate(1, 1))};
+  double* d{static_cast<double*>(arena.allocate(sizeof(double), 8))};
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(d) % alignof(double), 0);
+  EXPECT_GT(reinterpret_cast<char*>(d), c);
+  EXPECT_EQ(arena.region_count(), 1);
+
+  // oversized request gets its own region
+  arena.allocate(4096, 16);
+  EXPECT_EQ(arena.region_count(), 2);
+  EXPECT_EQ(arena.bytes_allocated(), 1 + sizeof(double) + 4096);
+
+  arena.release();
+  EXPECT_EQ(arena.region_count(), 0);
+  EXPECT_EQ(arena.bytes_allocated(), 0);
+
+  // after release the arena starts with a region as large as the largest one
+  arena.allocate(4096, 16);
+  EXPECT_EQ(arena.region_count(), 1);
+}
+
+struct BPlusTreeArena {};
+struct GraphArena {};
+
+TEST(ArenaAllocatorTest, BPlusTree) {
+  using Alloc = ArenaAllocator<int, BPlusTreeArena>;
+  {
+    trees::BPlusTree<int, int, 8, Alloc> tree;
+    for (int i{}; i < 5000; ++i) {
+      tree.insert(i, i * 2);
+    }
+    for (int i{}; i < 5000; ++i) {
+      EXPECT_EQ(*tree.search(i), i * 2);
+    }
+    EXPECT_GT(Alloc::arena().bytes_allocated(), 0);
+  }
+  Alloc::arena().release();
+  EXPECT_EQ(Alloc::arena().bytes_allocated(), 0);
+}
+
+TEST(ArenaAllocatorTest, NonTrivialPayload) {
+  // helpers::Test owns heap memory, nodes are still destroyed one by one
+  using Alloc = ArenaAllocator<int, BPlusTreeArena>;
+  {
+    trees::BPlusTree<int, helpers::Test, 4, Alloc> tree;
+    for (int i{}; i < 500; ++i) {
+      tree.insert(i, helpers::Test{i});
+    }
+    EXPECT_EQ(tree.search(250)->num(), 250);
+  }
+  Alloc::arena().release();
+}
+
+TEST(ArenaAllocatorTest, AdjacencyList) {
+  using Alloc = ArenaAllocator<int, GraphArena>;
+  using Graph = graphs::AdjacencyList<int, int, Alloc>;
+  {
+    Graph graph{};
+    Graph::Vertex* prev{graph.add_vertex(0)};
+    for (int i{1}; i < 500; ++i) {
+      Graph::Vertex* next{graph.add_vertex(i)};
+      graph.add_edge(prev, next, i);
+      prev = next;
+    }
+    EXPECT_TRUE(graph.has_edge(graph.find_vertex(10), graph.find_vertex(11)));
+    EXPECT_FALSE(graph.has_edge(graph.find_vertex(11), graph.find_vertex(10)));
+    graph.remove_vertex(graph.find_vertex(250));
+    EXPECT_EQ(graph.find_vertex(250), nullptr);
+  }
+  Alloc::arena().release();
+}
+
+TEST(PerfTest, BPlusTreeBuildAndDiscard) {
+  struct PerfArena {};
+  using Alloc = ArenaAllocator<int, PerfArena>;
+  Timer timer{};
+  {
+    trees::BPlusTree<int, int, 16> tree;
+    for (int i{}; i < 500000; ++i) {
+      tree.insert(i, i);
+    }
+  }
+  double defaultTime{timer.elapsed()};
+  std::cout << "B+ TREE DEFAULT ALLOCATOR: " << defaultTime << "\n";
+
+  timer.reset();
+  {
+    trees::BPlusTree<int, int, 16, Alloc> tree;
+    for (int i{}; i < 500000; ++i) {
+      tree.insert(i, i);
+    }
+  }
+  Alloc::arena().release();
+  double arenaTime{timer.elapsed()};
+  std::cout << "B+ TREE ARENA ALLOCATOR: " << arenaTime << "\n";
+}
@@ -0,0 +1,177 @@
+#include <caching-allocator.hpp>
+#include <deque.hpp>
+#include <gtest/gtest.h>
+#include <helpers.hpp>
+#include <iostream>
+#include <thread>
+#include <timer.hpp>
+#include <tree.hpp>
+#include <vector.hpp>
+
+static_assert(concepts::Allocator<CachingAllocator<int>>);
+static_assert(concepts::Allocator<CachingAllocator<helpers::Test>>);
+
+static_assert(MagazineCache::size_class(1) == 0);
+static_assert(MagazineCache::size_class(16) == 0);
+static_assert(MagazineCache::size_class(17) == 1);
+static_assert(MagazineCache::size_class(129) == 8);
+static_assert(MagazineCache::class_size(8) == 160);
+static_assert(MagazineCache::class_size(MagazineCache::CLASS_COUNT - 1) ==
+              MagazineCache::MAX_CACHED_SIZE);
+
+TEST(MagazineCacheTest, SizeClasses) {
+  for (std::size_t sizeClass{}; sizeClass < MagazineCache::CLASS_COUNT;
+       ++sizeClass) {
+    std::size_t size{MagazineCache::class_size(sizeClass)};
+    EXPECT_EQ(MagazineCache::size_class(size), sizeClass);
+    EXPECT_EQ(MagazineCache::size_class(size + 1), sizeClass + 1);
+    EXPECT_GE(MagazineCache::batch_size(sizeClass), 2);
+  }
+}
+
+TEST(MagazineCacheTest, RecyclesOnThread) {
+  std::size_t sizeClass{MagazineCache::size_class(40)};
+  void* first{MagazineCache::allocate(40)};
+  MagazineCache::deallocate(first);
+  MagazineCache::Stats before{MagazineCache::thread_stats(sizeClass)};
+  // the magazine is LIFO, the block we just gave back is handed out again
+  void* second{MagazineCache::allocate(33)};
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(MagazineCache::thread_stats(sizeClass).hits, before.hits + 1);
+  MagazineCache::deallocate(second);
+
+  // bigger than any size class
+  void* large{MagazineCache::allocate(MagazineCache::MAX_CACHED_SIZE + 1)};
+  EXPECT_NE(large, nullptr);
+  MagazineCache::deallocate(large);
+  MagazineCache::deallocate(nullptr);
+}
+
+TEST(MagazineCacheTest, BatchesThroughDepot) {
+  // a size class no other test uses
+  constexpr std::size_t bytes{3000};
+  std::size_t sizeClass{MagazineCache::size_class(bytes)};
+  std::size_t blockCount{MagazineCache::magazine_capacity(sizeClass) * 4};
+
+  std::thread worker{[&] {
+    void* blocks[64]{};
+    for (std::size_t i{}; i < blockCount; ++i) {
+      blocks[i] = MagazineCache::allocate(bytes);
+    }
+    for (std::size_t i{}; i < blockCount; ++i) {
+      MagazineCache::deallocate(blocks[i]);
+    }
+    EXPECT_GT(MagazineCache::thread_stats(sizeClass).flushes, 0);
+  }};
+  worker.join();
+
+  // the worker's blocks are now in the depot, so this thread gets whole
+  // batches instead of going to the system
+  void* blocks[64]{};
+  for (std::size_t i{}; i < blockCount; ++i) {
+    blocks[i] = MagazineCache::allocate(bytes);
+  }
+  MagazineCache::Stats stats{MagazineCache::thread_stats(sizeClass)};
+  EXPECT_EQ(stats.misses, stats.refills);
+  EXPECT_GT(stats.hits, stats.misses);
+  for (std::size_t i{}; i < blockCount; ++i) {
+    MagazineCache::deallocate(blocks[i]);
+  }
+
+  MagazineCache::Stats global{MagazineCache::global_stats(sizeClass)};
+  EXPECT_GE(global.misses, blockCount / 4);
+  EXPECT_GT(global.hit_rate(), 0.0);
+}
+
+TEST(MagazineCacheTest, CrossThreadFree) {
+  constexpr std::size_t count{10000};
+  int** values{new int*[count]};
+  std::thread producer{[&] {
+    CachingAllocator<int> alloc{};
+    for (std::size_t i{}; i < count; ++i) {
+      values[i] = alloc.allocate(1);
+      alloc.construct(values[i], static_cast<int>(i));
+    }
+  }};
+  producer.join();
+  std::thread consumer{[&] {
+    CachingAllocator<int> alloc{};
+    for (std::size_t i{}; i < count; ++i) {
+      EXPECT_EQ(*values[i], static_cast<int>(i));
+      alloc.deallocate(values[i], 1);
+    }
+  }};
+  consumer.join();
+  delete[] values;
+}
+
+TEST(CachingAllocatorTest, Containers) {
+  auto work{[](int seed) {
+    Vector<int, CachingAllocator<int>> vector{};
+    Deque<helpers::Test, CachingAllocator<helpers::Test>> deque{};
+    trees::AVLTree<int, helpers::Test, CachingAllocator<int>> avl;
+    for (int i{}; i < 5000; ++i) {
+      vector.push_back(i + seed);
+      deque.push_front(helpers::Test{i});
+      avl.push(i, helpers::Test{i + seed});
+    }
+    for (int i{}; i < 5000; i += 2) {
+      avl.remove(i);
+    }
+    for (int i{}; i < 5000; ++i) {
+      EXPECT_EQ(vector[static_cast<std::size_t>(i)], i + seed);
+      EXPECT_EQ(deque[static_cast<std::size_t>(4999 - i)].num(), i);
+      EXPECT_EQ(avl.search(i) == nullptr, i % 2 == 0);
+    }
+    EXPECT_TRUE(avl.is_binary_search_tree());
+  }};
+
+  std::thread workers[4]{};
+  for (int i{}; i < 4; ++i) {
+    workers[i] = std::thread{work, i * 10000};
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+template <template <typename> typename Alloc> void build_and_discard() {
+  for (int round{}; round < 20; ++round) {
+    trees::AVLTree<int, helpers::Test, Alloc<int>> avl;
+    Vector<int, Alloc<int>> vector{};
+    for (int i{}; i < 5000; ++i) {
+      avl.push(i, helpers::Test{i});
+      vector.push_back(i);
+    }
+  }
+}
+
+TEST(PerfTest, MultiThreadedContainers) {
+  constexpr int threadCount{4};
+  std::thread workers[threadCount]{};
+
+  Timer timer{};
+  for (std::thread& worker : workers) {
+    worker = std::thread{build_and_discard<Allocator>};
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  std::cout << "DEFAULT ALLOCATOR: " << timer.elapsed() << "\n";
+
+  timer.reset();
+  for (std::thread& worker : workers) {
+    worker = std::thread{build_and_discard<CachingAllocator>};
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  std::cout << "CACHING ALLOCATOR: " << timer.elapsed() << "\n";
+
+  MagazineCache::Stats total{};
+  for (std::size_t sizeClass{}; sizeClass < MagazineCache::CLASS_COUNT;
+       ++sizeClass) {
+    total += MagazineCache::global_stats(sizeClass);
+  }
+  std::cout << "CACHE HIT RATE: " << total.hit_rate() << "\n";
+}
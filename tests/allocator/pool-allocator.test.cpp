@@ -0,0 +1,156 @@
+#include <allocator.hpp>
+#include <fibonacci-heap.hpp>
+#include <gtest/gtest.h>
+#include <helpers.hpp>
+#include <iostream>
+#include <pool-allocator.hpp>
+#include <string>
+#include <timer.hpp>
+#include <tree.hpp>
+
+static_assert(concepts::Allocator<PoolAllocator<int>>);
+static_assert(concepts::Allocator<PoolAllocator<helpers::Test>>);
+
+TEST(PoolAllocatorTest, RecyclesFreedBlocks) {
+  PoolAllocator<long long> alloc{};
+  long long* first{alloc.allocate(1)};
+  long long* second{alloc.allocate(1)};
+  EXPECT_NE(first, second);
+
+  alloc.deallocate(first, 1);
+  // free list is LIFO, the block we just gave back is handed out again
+  EXPECT_EQ(alloc.allocate(1), first);
+
+  alloc.deallocate(first, 1);
+  alloc.deallocate(second, 1);
+}
+
+TEST(PoolAllocatorTest, CarvesChunks) {
+  using Alloc = PoolAllocator<double, 16>;
+  Alloc alloc{};
+  std::size_t chunksBefore{Alloc::pool().chunk_count()};
+  double* blocks[40]{};
+  for (double*& block : blocks) {
+    block = alloc.allocate(1);
+    alloc.construct(block, 1.5);
+  }
+  // 40 blocks of 16 per chunk
+  EXPECT_EQ(Alloc::pool().chunk_count() - chunksBefore, 3);
+  for (double* block : blocks) {
+    EXPECT_EQ(*block, 1.5);
+    alloc.deallocate(block, 1);
+  }
+  for (double*& block : blocks) {
+    block = alloc.allocate(1);
+  }
+  EXPECT_EQ(Alloc::pool().chunk_count() - chunksBefore, 3);
+  for (double* block : blocks) {
+    alloc.deallocate(block, 1);
+  }
+}
+
+TEST(PoolAllocatorTest, ArrayFallback) {
+  PoolAllocator<int> alloc{};
+  int* arr{alloc.allocate(8)};
+  for (int i{}; i < 8; ++i) {
+    arr[i] = i;
+  }
+  EXPECT_EQ(arr[7], 7);
+  alloc.deallocate(arr, 8);
+}
+
+TEST(PoolAllocatorTest, Trees) {
+  trees::AVLTree<int, helpers::Test, PoolAllocator<int>> avl;
+  trees::RBT<int, helpers::Test, PoolAllocator<int>> rbt;
+  trees::SplayTree<int, helpers::Test, PoolAllocator<int>> splay;
+  trees::BST<int, PoolAllocator<int>> bst;
+  trees::BTree<int, helpers::Test, 3, PoolAllocator> btree;
+  trees::BPlusTree<int, helpers::Test, 3, PoolAllocator<int>> bplus;
+  for (int i{}; i < 1000; ++i) {
+    avl.push(i, helpers::Test{i});
+    rbt.push(i, helpers::Test{i});
+    splay.push(i, helpers::Test{i});
+    bst.push(i % 2 ? i : -i);
+    btree.insert(i, helpers::Test{i});
+    bplus.insert(i, helpers::Test{i});
+  }
+  for (int i{}; i < 1000; ++i) {
+    EXPECT_EQ(bplus.search(i)->num(), i);
+  }
+  for (int i{}; i < 1000; i += 2) {
+    avl.remove(i);
+    rbt.remove(i);
+    splay.remove(i);
+    btree.remove(i);
+  }
+  for (int i{}; i < 1000; ++i) {
+    bool isRemoved{i % 2 == 0};
+    EXPECT_EQ(avl.search(i) == nullptr, isRemoved);
+    EXPECT_EQ(rbt.search(i) == nullptr, isRemoved);
+    EXPECT_EQ(splay.search(i) == nullptr, isRemoved);
+    EXPECT_EQ(btree.search(i) == nullptr, isRemoved);
+  }
+  EXPECT_TRUE(avl.is_binary_search_tree());
+  EXPECT_TRUE(bst.is_binary_search_tree());
+
+  trees::GeneralTrie<char, PoolAllocator<void>> trie;
+  trie.push(std::string{"pool"});
+  trie.push(std::string{"pooling"});
+  EXPECT_TRUE(trie.search("pool"));
+  EXPECT_FALSE(trie.search("poo"));
+}
+
+TEST(PoolAllocatorTest, Heaps) {
+  FibonacciHeap<int, helpers::Test, std::less_equal<int>, PoolAllocator<int>>
+      heap;
+  for (int i{100}; i > 0; --i) {
+    heap.insert(i, helpers::Test{i});
+  }
+  for (int i{1}; i <= 100; ++i) {
+    EXPECT_EQ(heap.extract_top().first, i);
+  }
+}
+
+TEST(PerfTest, AVLInsertion) {
+  Timer timer{};
+  {
+    trees::AVLTree<int, helpers::Test> avl;
+    for (int i{}; i < 200000; ++i) {
+      avl.push(i, helpers::Test{i});
+    }
+  }
+  double defaultTime{timer.elapsed()};
+  std::cout << "AVL DEFAULT ALLOCATOR: " << defaultTime << "\n";
+
+  timer.reset();
+  {
+    trees::AVLTree<int, helpers::Test, PoolAllocator<int>> avl;
+    for (int i{}; i < 200000; ++i) {
+      avl.push(i, helpers::Test{i});
+    }
+  }
+  double poolTime{timer.elapsed()};
+  std::cout << "AVL POOL ALLOCATOR: " << poolTime << "\n";
+}
+
+TEST(PerfTest, RBTInsertion) {
+  Timer timer{};
+  {
+    trees::RBT<int, helpers::Test> rbt;
+    for (int i{}; i < 200000; ++i) {
+      rbt.push(i, helpers::Test{i});
+    }
+  }
+  double defaultTime{timer.elapsed()};
+  std::cout << "RBT DEFAULT ALLOCATOR: " << defaultTime << "\n";
+
+  timer.reset();
+  {
+    trees::RBT<int, helpers::Test, PoolAllocator<int>> rbt;
+    for (int i{}; i < 200000; ++i) {
+      rbt.push(i, helpers::Test{i});
+    }
+  }
+  double poolTime{timer.elapsed()};
+  std::cout << "RBT POOL ALLOCATOR: " << poolTime << "\n";
+}
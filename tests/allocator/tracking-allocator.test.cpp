@@ -0,0 +1,117 @@
+#include <arena-allocator.hpp>
+#include <cstring>
+#include <deque.hpp>
+#include <gtest/gtest.h>
+#include <helpers.hpp>
+#include <iostream>
+#include <pool-allocator.hpp>
+#include <thread>
+#include <tracking-allocator.hpp>
+#include <tree.hpp>
+#include <vector.hpp>
+
+struct VectorPool {
+  static constexpr const char name[]{"Vector"};
+};
+struct DequePool {
+  static constexpr const char name[]{"Deque"};
+};
+struct TreePool {
+  static constexpr const char name[]{"AVLTree"};
+};
+struct ThreadedPool {
+  static constexpr const char name[]{"Threaded"};
+};
+struct ArenaPool {
+  static constexpr const char name[]{"Arena"};
+};
+
+static_assert(concepts::Allocator<TrackingAllocator<int>>);
+static_assert(concepts::Allocator<
+              TrackingAllocator<int, TreePool, PoolAllocator<int>>>);
+static_assert(concepts::MonotonicAllocator<
+              TrackingAllocator<int, ArenaPool, ArenaAllocator<int>>>);
+static_assert(!concepts::MonotonicAllocator<TrackingAllocator<int>>);
+
+TEST(TrackingAllocatorTest, LiveAndPeakBytes) {
+  using Alloc = TrackingAllocator<int, VectorPool>;
+  {
+    Vector<int, Alloc> vector(4);
+    EXPECT_EQ(Alloc::stats().liveBytes, 4 * sizeof(int));
+    for (int i{}; i < 100; ++i) {
+      vector.push_back(i);
+    }
+    EXPECT_EQ(Alloc::stats().liveBytes, vector.capacity() * sizeof(int));
+    EXPECT_EQ(Alloc::stats().live_allocations(), 1);
+    EXPECT_GT(Alloc::stats().peakBytes, Alloc::stats().liveBytes);
+  }
+  TrackedPool::Stats stats{Alloc::stats()};
+  EXPECT_EQ(stats.liveBytes, 0);
+  EXPECT_EQ(stats.live_allocations(), 0);
+  EXPECT_GT(stats.allocations, 1);
+
+  Alloc::pool().reset_peak();
+  EXPECT_EQ(Alloc::stats().peakBytes, 0);
+}
+
+TEST(TrackingAllocatorTest, PoolPerContainerType) {
+  Deque<helpers::Test, TrackingAllocator<helpers::Test, DequePool>> deque{};
+  trees::AVLTree<int, helpers::Test,
+                 TrackingAllocator<int, TreePool, PoolAllocator<int>>>
+      avl;
+  for (int i{}; i < 1000; ++i) {
+    deque.push_back(helpers::Test{i});
+    avl.push(i, helpers::Test{i});
+  }
+  // blocks and the block map both count towards the deque
+  EXPECT_GE(TrackedPool::of<DequePool>().stats().liveBytes,
+            1000 * sizeof(helpers::Test));
+  // one allocation per node, rebound from int
+  EXPECT_EQ(TrackedPool::of<TreePool>().stats().live_allocations(), 1000);
+
+  for (int i{}; i < 1000; i += 2) {
+    avl.remove(i);
+  }
+  EXPECT_EQ(TrackedPool::of<TreePool>().stats().live_allocations(), 500);
+
+  bool foundDeque{false};
+  bool foundTree{false};
+  TrackedPool::for_each([&](const TrackedPool& pool) {
+    foundDeque |= std::strcmp(pool.name(), "Deque") == 0;
+    foundTree |= std::strcmp(pool.name(), "AVLTree") == 0;
+  });
+  EXPECT_TRUE(foundDeque);
+  EXPECT_TRUE(foundTree);
+}
+
+TEST(TrackingAllocatorTest, Threads) {
+  using Alloc = TrackingAllocator<int, ThreadedPool>;
+  std::thread workers[4]{};
+  for (std::thread& worker : workers) {
+    worker = std::thread{[] {
+      for (int round{}; round < 100; ++round) {
+        Vector<int, Alloc> vector{};
+        for (int i{}; i < 100; ++i) {
+          vector.push_back(i);
+        }
+      }
+    }};
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  TrackedPool::Stats stats{Alloc::stats()};
+  EXPECT_EQ(stats.liveBytes, 0);
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_GT(stats.peakBytes, 0);
+}
+
+TEST(TrackingAllocatorTest, Report) {
+  Vector<int, TrackingAllocator<int, VectorPool>> vector(1000);
+  TrackedPool::for_each([](const TrackedPool& pool) {
+    TrackedPool::Stats stats{pool.stats()};
+    std::cout << pool.name() << ": live " << stats.liveBytes << " peak "
+              << stats.peakBytes << " allocations " << stats.allocations
+              << "\n";
+  });
+}
@@ -0,0 +1,123 @@
+#include <atomic>
+#include <cstddef>
+#include <epoch.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector.hpp>
+
+std::atomic<int> freed{0};
+
+void countingDelete(void* pointer) {
+  delete static_cast<int*>(pointer);
+  freed.fetch_add(1);
+}
+
+TEST(EpochTest, WaitsForPinnedThreads) {
+  epoch::reclaim();
+  freed.store(0);
+  std::atomic<bool> pinned{false};
+  std::atomic<bool> release{false};
+  std::thread reader{[&]() {
+    epoch::Guard guard{};
+    pinned.store(true);
+    while (!release.load()) {
+      std::this_thread::yield();
+    }
+  }};
+  while (!pinned.load()) {
+    std::this_thread::yield();
+  }
+
+  epoch::retire(new int{1}, countingDelete);
+  epoch::reclaim();
+  EXPECT_EQ(freed.load(), 0);
+  EXPECT_EQ(epoch::pending(), 1);
+
+  release.store(true);
+  reader.join();
+  epoch::reclaim();
+  EXPECT_EQ(freed.load(), 1);
+  EXPECT_EQ(epoch::pending(), 0);
+}
+
+TEST(EpochTest, GuardsNest) {
+  epoch::reclaim();
+  freed.store(0);
+  {
+    epoch::Guard outer{};
+    {
+      epoch::Guard inner{};
+    }
+    // still pinned by outer, the epoch can move once but not twice
+    epoch::retire(new int{1}, countingDelete);
+    epoch::reclaim();
+    EXPECT_EQ(freed.load(), 0);
+  }
+  epoch::reclaim();
+  EXPECT_EQ(freed.load(), 1);
+}
+
+TEST(EpochTest, ExitedThreadsLeaveTheirGarbage) {
+  epoch::reclaim();
+  freed.store(0);
+  std::thread worker{[]() {
+    for (int i{}; i < 10; ++i) {
+      epoch::retire(new int{i}, countingDelete);
+    }
+  }};
+  worker.join();
+  epoch::reclaim();
+  EXPECT_EQ(freed.load(), 10);
+}
+
+// without anyone calling reclaim(), the retirements of live threads free
+// what exited threads left behind
+TEST(EpochTest, RetireDrainsOrphans) {
+  epoch::reclaim();
+  freed.store(0);
+  std::thread worker{[]() {
+    for (int i{}; i < 10; ++i) {
+      epoch::retire(new int{i}, countingDelete);
+    }
+  }};
+  worker.join();
+  for (std::size_t i{}; i < 4 * epoch::detail::ADVANCE_EVERY; ++i) {
+    epoch::retire(new long{0});
+  }
+  EXPECT_EQ(freed.load(), 10);
+  epoch::reclaim();
+}
+
+// writers keep swapping a shared object while readers read it; under ASan a
+// reader touching a freed object fails the test
+TEST(EpochTest, ReadersNeverSeeFreedObjects) {
+  std::atomic<int*> shared{new int{0}};
+  std::atomic<bool> done{false};
+  Vector<std::thread> threads(6);
+  for (int i{}; i < 4; ++i) {
+    threads.push_back(std::thread{[&]() {
+      long long sum{};
+      while (!done.load()) {
+        epoch::Guard guard{};
+        sum += *shared.load();
+      }
+      EXPECT_GE(sum, 0);
+    }});
+  }
+  for (int i{}; i < 2; ++i) {
+    threads.push_back(std::thread{[&]() {
+      for (int j{}; j < 20000; ++j) {
+        epoch::Guard guard{};
+        epoch::retire(shared.exchange(new int{j}));
+      }
+    }});
+  }
+  threads[4].join();
+  threads[5].join();
+  done.store(true);
+  for (std::size_t i{}; i < 4; ++i) {
+    threads[i].join();
+  }
+  delete shared.load();
+  epoch::reclaim();
+}
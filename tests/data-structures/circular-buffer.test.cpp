@@ -3,6 +3,9 @@
 #include <cstddef>
 #include <gtest/gtest.h>
 #include <helpers.hpp>
+#include <span>
+#include <type_traits>
+#include <utility>
 
 using TestObj = helpers::Test;
 class CircularBufferTest : public ::testing::Test {
@@ -458,4 +461,43 @@ TEST_F(CircularBufferTest, EraseMany) {
   }
   EXPECT_EQ(index, 2);
   EXPECT_EQ(iter, buff.end());
-}
\ No newline at end of file
+}
+TEST_F(CircularBufferTest, Segments) {
+  for (int i{}; i < 4; ++i) {
+    buffer1.push_back(TestObj{i});
+  }
+  auto [first, second] = buffer1.segments();
+  EXPECT_EQ(first.size(), 4);
+  EXPECT_TRUE(second.empty());
+
+  // 5 wraps around the end: 2 3 4 | 5
+  buffer1.pop_front();
+  buffer1.pop_front();
+  buffer1.push_back(TestObj{4});
+  buffer1.push_back(TestObj{5});
+  int expected{2};
+  std::size_t sizes[2]{};
+  std::size_t runs{};
+  buffer1.for_each_segment([&](std::span<TestObj> segment) {
+    for (const TestObj& i : segment) {
+      EXPECT_EQ(i.num(), expected++);
+    }
+    sizes[runs++] = segment.size();
+  });
+  EXPECT_EQ(runs, 2);
+  EXPECT_EQ(sizes[0], 3);
+  EXPECT_EQ(sizes[1], 1);
+  EXPECT_EQ(expected, 6);
+
+  // a const buffer only hands out read-only runs
+  const CircularBuffer<TestObj, 5>& constBuffer{buffer1};
+  static_assert(std::is_same_v<decltype(constBuffer.segments()),
+                               std::array<std::span<const TestObj>, 2>>);
+  std::size_t total{};
+  constBuffer.for_each_segment([&](auto segment) {
+    static_assert(std::is_const_v<
+                  typename decltype(segment)::element_type>);
+    total += segment.size();
+  });
+  EXPECT_EQ(total, 4);
+}
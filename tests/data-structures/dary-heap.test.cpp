@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cstddef>
+#include <dary-heap.hpp>
+#include <functional>
+#include <gtest/gtest.h>
+#include <heap.hpp>
+#include <helpers.hpp>
+#include <iostream>
+#include <priority-queue.hpp>
+#include <random>
+#include <timer.hpp>
+#include <vector.hpp>
+
+Vector<int> randomValues(std::size_t count, int max) {
+  std::mt19937 rng{7};
+  std::uniform_int_distribution<int> value{0, max};
+  Vector<int> values(count);
+  for (std::size_t i{}; i < count; ++i) {
+    values.push_back(value(rng));
+  }
+  return values;
+}
+
+// pops come out sorted, duplicates included
+template <std::size_t Arity> void popsSorted() {
+  Vector<int> values{randomValues(1000, 100)};
+  DaryMinHeap<int, Arity> heap{};
+  for (int i : values) {
+    heap.push(i);
+  }
+  EXPECT_EQ(heap.size(), 1000);
+  std::sort(values.begin(), values.end());
+  for (int i : values) {
+    EXPECT_EQ(heap.top(), i);
+    EXPECT_EQ(heap.pop(), i);
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(DaryHeapTest, PopsSorted) {
+  popsSorted<2>();
+  popsSorted<3>();
+  popsSorted<4>();
+  popsSorted<8>();
+  popsSorted<16>();
+}
+
+TEST(DaryHeapTest, Heapify) {
+  Vector<int> values{randomValues(777, 1000)};
+  DaryMaxHeap<int, 4> heap(values.begin(), values.end());
+  std::sort(values.begin(), values.end(), std::greater<int>{});
+  for (int i : values) {
+    EXPECT_EQ(heap.pop(), i);
+  }
+
+  DaryMinHeap<helpers::Test, 3> tests{helpers::Test{5}, helpers::Test{-1},
+                                      helpers::Test{3}};
+  EXPECT_EQ(tests.pop().num(), -1);
+  EXPECT_EQ(tests.pop().num(), 3);
+  EXPECT_EQ(tests.pop().num(), 5);
+}
+
+TEST(DaryHeapTest, Remove) {
+  Vector<int> values{randomValues(200, 50)};
+  DaryMinHeap<int, 4> heap(values.begin(), values.end());
+  Vector<int> left(values.size());
+  // removing from the middle may have to sift either way
+  for (std::size_t i{}; i < 50; ++i) {
+    heap.remove((i * 37) % heap.size());
+  }
+  while (!heap.empty()) {
+    left.push_back(heap.pop());
+  }
+  EXPECT_EQ(left.size(), 150);
+  EXPECT_TRUE(std::is_sorted(left.begin(), left.end()));
+}
+
+TEST(DaryHeapTest, PriorityQueueBackend) {
+  DaryPriorityQueue<int, 8, std::greater_equal<int>> queue{};
+  for (int i{}; i < 100; ++i) {
+    queue.push((i * 31) % 100);
+  }
+  for (int i{99}; i >= 0; --i) {
+    EXPECT_EQ(queue.pop(), i);
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+// push everything, then pop everything
+template <typename H> double pushPop(const Vector<int>& values) {
+  Timer timer{};
+  H heap{};
+  for (std::size_t i{}; i < values.size(); ++i) {
+    heap.push(values[i]);
+  }
+  long long sum{};
+  while (!heap.empty()) {
+    sum += heap.pop();
+  }
+  double elapsed{timer.elapsed()};
+  EXPECT_GT(sum, 0);
+  return elapsed;
+}
+
+TEST(PerfTest, DaryHeapMatrix) {
+  constexpr std::size_t sizes[]{10'000, 100'000, 1'000'000, 10'000'000};
+  for (std::size_t size : sizes) {
+    Vector<int> values{randomValues(size, 1 << 30)};
+    double binary{pushPop<MinHeap<int>>(values)};
+    double two{pushPop<DaryMinHeap<int, 2>>(values)};
+    double four{pushPop<DaryMinHeap<int, 4>>(values)};
+    double eight{pushPop<DaryMinHeap<int, 8>>(values)};
+    double sixteen{pushPop<DaryMinHeap<int, 16>>(values)};
+    std::cout << size << " INTS: HEAP " << binary << " s, ARITY 2 " << two
+              << " s, ARITY 4 " << four << " s, ARITY 8 " << eight
+              << " s, ARITY 16 " << sixteen << " s\n";
+  }
+}
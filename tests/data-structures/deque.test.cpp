@@ -1,3 +1,5 @@
+#include <algorithm.hpp>
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <deque.hpp>
@@ -5,7 +7,10 @@
 #include <gtest/gtest.h>
 #include <helpers.hpp>
 #include <iostream>
+#include <span>
 #include <timer.hpp>
+#include <type_traits>
+#include <tracking-allocator.hpp>
 #include <tracy/Tracy.hpp>
 
 #define TRACY_NO_EXIT 1
@@ -212,6 +217,231 @@ TEST_F(ContainerTest, PopFront) {
   }
 }
 
+struct FifoPool {
+  static constexpr const char name[]{"Deque FIFO"};
+};
+
+TEST(DequeTest, SteadyFifoReusesBlocks) {
+  using Alloc = TrackingAllocator<int, FifoPool>;
+  // 64 byte blocks, 16 ints each
+  Deque<int, Alloc, 64> c{};
+  for (int i{}; i < 100; ++i) {
+    c.push_back(i);
+  }
+  std::size_t allocations{Alloc::stats().allocations};
+  for (int i{100}; i < 10000; ++i) {
+    c.push_back(i);
+    ASSERT_EQ(c.pop_front(), i - 100);
+  }
+  EXPECT_EQ(c.size(), 100);
+  EXPECT_EQ(c.front(), 9900);
+  EXPECT_EQ(c.back(), 9999);
+  // only the map may have grown, blocks all come from the spares
+  EXPECT_LE(Alloc::stats().allocations - allocations, 2);
+
+  std::size_t liveBytes{Alloc::stats().liveBytes};
+  while (c.size() > 1) {
+    c.pop_front();
+  }
+  c.shrink_to_fit();
+  EXPECT_LT(Alloc::stats().liveBytes, liveBytes);
+  EXPECT_EQ(c.front(), 9999);
+}
+
+TEST(DequeTest, PopBackIntoPartialHead) {
+  Deque<int, Allocator<int>, 64> c{};
+  for (int i{}; i < 40; ++i) {
+    c.push_back(i);
+  }
+  c.pop_front();
+  while (c.size() > 1) {
+    c.pop_back();
+  }
+  EXPECT_EQ(c.back(), 1);
+  c.push_back(2);
+  EXPECT_EQ(c[1], 2);
+  c.pop_back();
+  c.pop_back();
+  EXPECT_TRUE(c.empty());
+  c.push_front(5);
+  EXPECT_EQ(c.front(), 5);
+  EXPECT_EQ(c.back(), 5);
+}
+
+TEST(DequeTest, Segments) {
+  Deque<int, Allocator<int>, 64> c{};
+  EXPECT_EQ(c.segments().begin(), c.segments().end());
+  // both ends grow, so blocks fill from either side and wrap
+  for (int i{}; i < 100; ++i) {
+    c.push_back(i);
+    c.push_front(-i);
+  }
+  for (int i{}; i < 7; ++i) {
+    c.pop_front();
+  }
+
+  Vector<int> bySegments(c.size());
+  c.for_each_segment([&](std::span<int> segment) {
+    EXPECT_FALSE(segment.empty());
+    for (int i : segment) {
+      bySegments.push_back(i);
+    }
+  });
+  std::size_t index{};
+  for (std::span<int> segment : c.segments()) {
+    for (int i : segment) {
+      EXPECT_EQ(i, bySegments[index++]);
+    }
+  }
+  EXPECT_EQ(index, c.size());
+  index = 0;
+  for (int i : c) {
+    EXPECT_EQ(i, bySegments[index++]);
+  }
+}
+
+template <typename Container>
+concept Fillable =
+    requires(Container& container) { algorithms::fill(container, 0); };
+
+TEST(DequeTest, ConstSegmentsAreReadOnly) {
+  using IntDeque = Deque<int, Allocator<int>, 64>;
+  static_assert(Fillable<IntDeque>);
+  static_assert(!Fillable<const IntDeque>);
+  static_assert(
+      std::is_same_v<decltype(*std::declval<const IntDeque&>()
+                                  .segments()
+                                  .begin()),
+                     std::span<const int>>);
+
+  IntDeque c{};
+  for (int i{}; i < 200; ++i) {
+    c.push_front(i);
+  }
+  algorithms::fill(c, 4);
+  const IntDeque& constDeque{c};
+  EXPECT_EQ(algorithms::count(constDeque, 4), 200);
+  std::size_t total{};
+  for (std::span<const int> segment : constDeque.segments()) {
+    total += segment.size();
+  }
+  EXPECT_EQ(total, 200);
+}
+
+TEST(DequeTest, SegmentedAlgorithms) {
+  Deque<int, Allocator<int>, 64> c{};
+  for (int i{}; i < 300; ++i) {
+    c.push_back((i * 37) % 101);
+    c.push_front((i * 53) % 97);
+  }
+  auto position = [&](auto iter) {
+    return static_cast<std::size_t>(iter - c.begin());
+  };
+  for (int needle : {0, 42, 96, 200}) {
+    EXPECT_EQ(algorithms::find(c, needle),
+              position(std::find(c.begin(), c.end(), needle)));
+    EXPECT_EQ(algorithms::count(c, needle),
+              static_cast<std::size_t>(std::count(c.begin(), c.end(), needle)));
+  }
+  EXPECT_EQ(algorithms::min_element(c),
+            position(std::min_element(c.begin(), c.end())));
+  EXPECT_EQ(algorithms::max_element(c),
+            position(std::max_element(c.begin(), c.end())));
+
+  long long sum{};
+  algorithms::for_each(c, [&](int i) { sum += i; });
+  long long expected{};
+  for (int i : c) {
+    expected += i;
+  }
+  EXPECT_EQ(sum, expected);
+
+  algorithms::fill(c, 7);
+  EXPECT_EQ(algorithms::count(c, 7), c.size());
+}
+
+TEST(PerfTest, SegmentedScan) {
+  constexpr int size{1 << 20};
+  constexpr int rounds{20};
+  Deque<int> c{};
+  for (int i{}; i < size; ++i) {
+    c.push_back(i);
+  }
+
+  std::size_t found{};
+  Timer timer{};
+  for (int round{}; round < rounds; ++round) {
+    found += static_cast<std::size_t>(
+        std::find(c.begin(), c.end(), -round) - c.begin());
+  }
+  double iteratorTime{timer.elapsed()};
+  std::size_t segmentedFound{};
+  timer.reset();
+  for (int round{}; round < rounds; ++round) {
+    segmentedFound += algorithms::find(c, -round);
+  }
+  double segmentedTime{timer.elapsed()};
+  EXPECT_EQ(found, segmentedFound);
+  std::cout << "FIND ITERATOR: " << iteratorTime
+            << " s, SEGMENTS: " << segmentedTime << " s\n";
+
+  long long sum{};
+  timer.reset();
+  for (int round{}; round < rounds; ++round) {
+    for (int i : c) {
+      sum += i;
+    }
+  }
+  iteratorTime = timer.elapsed();
+  long long segmentedSum{};
+  timer.reset();
+  for (int round{}; round < rounds; ++round) {
+    algorithms::for_each(c, [&](int i) { segmentedSum += i; });
+  }
+  segmentedTime = timer.elapsed();
+  EXPECT_EQ(sum, segmentedSum);
+  std::cout << "SUM ITERATOR: " << iteratorTime
+            << " s, SEGMENTS: " << segmentedTime << " s\n";
+}
+
+TEST(PerfTest, SteadyFifo) {
+  constexpr int depth{10000};
+  constexpr int rounds{5000000};
+  long long sum{};
+
+  auto run{[&](auto& queue, auto pop) {
+    for (int i{}; i < depth; ++i) {
+      queue.push_back(i);
+    }
+    Timer timer{};
+    for (int i{}; i < rounds; ++i) {
+      queue.push_back(i);
+      sum += pop(queue);
+    }
+    return timer.elapsed();
+  }};
+
+  std::deque<int> stdQueue{};
+  double elapsed{run(stdQueue, [](std::deque<int>& q) {
+    int value{q.front()};
+    q.pop_front();
+    return value;
+  })};
+  std::cout << "STD DEQUE: " << elapsed << "\n";
+
+  auto popFront{[](auto& q) { return q.pop_front(); }};
+  Deque<int, Allocator<int>, 64> lineBlocks{};
+  elapsed = run(lineBlocks, popFront);
+  std::cout << "DEQUE 64 B BLOCKS: " << elapsed << "\n";
+  Deque<int> defaultBlocks{};
+  elapsed = run(defaultBlocks, popFront);
+  std::cout << "DEQUE 4 KiB BLOCKS: " << elapsed << "\n";
+  Deque<int, Allocator<int>, 65536> bigBlocks{};
+  elapsed = run(bigBlocks, popFront);
+  std::cout << "DEQUE 64 KiB BLOCKS: " << elapsed << "\n";
+  EXPECT_GT(sum, 0);
+}
+
 TEST(PerfTest, StdDeque) {
   // ZoneScopedN("TEST StdDeque");
   Timer timer{};
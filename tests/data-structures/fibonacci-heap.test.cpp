@@ -1,11 +1,18 @@
 #include <array>
+#include <cstddef>
 #include <fibonacci-heap.hpp>
 #include <gtest/gtest.h>
 #include <heap.hpp>
 #include <helpers.hpp>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <set>
 #include <string>
 #include <string_view>
+#include <timer.hpp>
+#include <utility>
+#include <vector.hpp>
 
 class ContainerTest : public ::testing::Test {
 public:
@@ -123,3 +130,151 @@ TEST_F(ContainerTest, FibonacciHeapDelete) {
   EXPECT_EQ(_heap.find(38), nullptr);
   EXPECT_EQ(_heap.top()->num(), 3);
 }
+
+TEST(FibonacciHeapTest, Handles) {
+  FibonacciHeap<int, int> heap{};
+  Vector<FibonacciHeap<int, int>::Handle> handles(1000);
+  std::multiset<int> expected{};
+  for (int i{}; i < 1000; ++i) {
+    int key{(i * 7919) % 10007};
+    handles.push_back(heap.insert(key, i));
+    expected.insert(key);
+  }
+  // pull a few nodes deep into trees before changing them
+  std::set<int> extracted{};
+  for (int i{}; i < 10; ++i) {
+    auto [key, value] = heap.extract_top();
+    expected.erase(expected.find(key));
+    extracted.insert(value);
+  }
+  auto live = [&](std::size_t i) {
+    return !extracted.contains(static_cast<int>(i));
+  };
+  for (std::size_t i{500}; i < 1000; i += 3) {
+    if (!live(i)) {
+      continue;
+    }
+    int key{handles[i].key()};
+    expected.erase(expected.find(key));
+    heap.decrease_key(handles[i], key - 20000);
+    expected.insert(key - 20000);
+    EXPECT_EQ(handles[i].value(), static_cast<int>(i));
+  }
+  for (std::size_t i{501}; i < 1000; i += 3) {
+    if (!live(i)) {
+      continue;
+    }
+    expected.erase(expected.find(handles[i].key()));
+    heap.erase(handles[i]);
+  }
+  EXPECT_EQ(heap.size(), static_cast<int>(expected.size()));
+  for (int key : expected) {
+    EXPECT_EQ(heap.extract_top().first, key);
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+// random graph in adjacency arrays: the edges of v are
+// targets[offsets[v]..offsets[v + 1])
+struct Graph {
+  Vector<std::size_t> offsets{};
+  Vector<int> targets{};
+  Vector<long long> weights{};
+};
+
+Graph randomGraph(int vertices, int edgesPerVertex) {
+  std::mt19937 rng{42};
+  std::uniform_int_distribution<int> vertex{0, vertices - 1};
+  std::uniform_int_distribution<int> weight{1, 1000};
+  Graph graph{};
+  for (int v{}; v < vertices; ++v) {
+    graph.offsets.push_back(graph.targets.size());
+    for (int e{}; e < edgesPerVertex; ++e) {
+      graph.targets.push_back(vertex(rng));
+      graph.weights.push_back(weight(rng));
+    }
+  }
+  graph.offsets.push_back(graph.targets.size());
+  return graph;
+}
+
+constexpr long long UNREACHED{std::numeric_limits<long long>::max()};
+
+// one handle per vertex, relaxing an edge decreases the key in place
+Vector<long long> dijkstraFibonacci(Graph& graph, int source) {
+  std::size_t vertices{graph.offsets.size() - 1};
+  using Heap = FibonacciHeap<long long, int>;
+  Vector<long long> distance(vertices);
+  Vector<Heap::Handle> handles(vertices);
+  for (std::size_t v{}; v < vertices; ++v) {
+    distance.push_back(UNREACHED);
+    handles.push_back(Heap::Handle{});
+  }
+  Heap heap{};
+  distance[static_cast<std::size_t>(source)] = 0;
+  heap.insert(0LL, source);
+  while (!heap.empty()) {
+    auto [d, v] = heap.extract_top();
+    std::size_t from{static_cast<std::size_t>(v)};
+    for (std::size_t e{graph.offsets[from]}; e < graph.offsets[from + 1];
+         ++e) {
+      std::size_t to{static_cast<std::size_t>(graph.targets[e])};
+      long long candidate{d + graph.weights[e]};
+      if (candidate >= distance[to]) {
+        continue;
+      }
+      if (distance[to] == UNREACHED) {
+        handles[to] = heap.insert(candidate, graph.targets[e]);
+      } else {
+        heap.decrease_key(handles[to], candidate);
+      }
+      distance[to] = candidate;
+    }
+  }
+  return distance;
+}
+
+// the binary heap cannot change a key, so it takes a new entry per
+// relaxation and skips the stale ones
+Vector<long long> dijkstraBinary(Graph& graph, int source) {
+  std::size_t vertices{graph.offsets.size() - 1};
+  Vector<long long> distance(vertices);
+  for (std::size_t v{}; v < vertices; ++v) {
+    distance.push_back(UNREACHED);
+  }
+  MinHeap<std::pair<long long, int>> heap{};
+  distance[static_cast<std::size_t>(source)] = 0;
+  heap.push({0, source});
+  while (!heap.empty()) {
+    auto [d, v] = heap.pop();
+    std::size_t from{static_cast<std::size_t>(v)};
+    if (d > distance[from]) {
+      continue;
+    }
+    for (std::size_t e{graph.offsets[from]}; e < graph.offsets[from + 1];
+         ++e) {
+      std::size_t to{static_cast<std::size_t>(graph.targets[e])};
+      long long candidate{d + graph.weights[e]};
+      if (candidate < distance[to]) {
+        distance[to] = candidate;
+        heap.push({candidate, graph.targets[e]});
+      }
+    }
+  }
+  return distance;
+}
+
+TEST(PerfTest, Dijkstra) {
+  Graph graph{randomGraph(100'000, 10)};
+  Timer timer{};
+  Vector<long long> binary{dijkstraBinary(graph, 0)};
+  double binaryTime{timer.elapsed()};
+  timer.reset();
+  Vector<long long> fibonacci{dijkstraFibonacci(graph, 0)};
+  double fibonacciTime{timer.elapsed()};
+  for (std::size_t v{}; v < binary.size(); ++v) {
+    ASSERT_EQ(binary[v], fibonacci[v]);
+  }
+  std::cout << "DIJKSTRA 1e6 EDGES: BINARY HEAP " << binaryTime
+            << " s, FIBONACCI HEAP " << fibonacciTime << " s\n";
+}
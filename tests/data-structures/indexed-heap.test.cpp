@@ -0,0 +1,151 @@
+#include <cstddef>
+#include <functional>
+#include <gtest/gtest.h>
+#include <heap.hpp>
+#include <indexed-heap.hpp>
+#include <iostream>
+#include <priority-queue.hpp>
+#include <random>
+#include <set>
+#include <timer.hpp>
+#include <utility>
+#include <vector.hpp>
+
+TEST(IndexedHeapTest, PushPopUpdateErase) {
+  IndexedHeap<int> heap{4};
+  EXPECT_TRUE(heap.empty());
+  heap.push(0, 50);
+  heap.push(1, 20);
+  heap.push(2, 40);
+  heap.push(9, 30);
+  EXPECT_EQ(heap.size(), 4);
+  EXPECT_EQ(heap.top(), 1);
+  EXPECT_TRUE(heap.contains(9));
+  EXPECT_FALSE(heap.contains(5));
+  EXPECT_FALSE(heap.contains(100));
+
+  heap.update(0, 10);
+  EXPECT_EQ(heap.top(), 0);
+  heap.update(0, 60);
+  EXPECT_EQ(heap.top(), 1);
+  // push of a present id changes its priority
+  heap.push(2, 5);
+  EXPECT_EQ(heap.priority(2), 5);
+  EXPECT_EQ(heap.size(), 4);
+
+  heap.erase(2);
+  EXPECT_FALSE(heap.contains(2));
+  EXPECT_THROW(heap.erase(2), IndexedHeap<int>::OutOfRangeException);
+
+  auto [id, priority] = heap.pop();
+  EXPECT_EQ(id, 1);
+  EXPECT_EQ(priority, 20);
+  EXPECT_EQ(heap.pop().first, 9);
+  EXPECT_EQ(heap.pop().first, 0);
+  EXPECT_TRUE(heap.empty());
+  // ids can come back after they left
+  heap.push(1, 1);
+  EXPECT_EQ(heap.top(), 1);
+}
+
+// random operations against an ordered set of (priority, id)
+TEST(IndexedHeapTest, MatchesOrderedSet) {
+  constexpr std::size_t ids{300};
+  std::mt19937 rng{3};
+  std::uniform_int_distribution<std::size_t> anyId{0, ids - 1};
+  std::uniform_int_distribution<int> anyPriority{0, 1000};
+  std::uniform_int_distribution<int> operation{0, 3};
+
+  IndexedHeap<int, std::greater_equal<int>> heap{};
+  std::set<std::pair<int, std::size_t>, std::greater<>> expected{};
+  Vector<int> priorities(ids);
+  for (std::size_t i{}; i < ids; ++i) {
+    priorities.push_back(-1);
+  }
+  for (int step{}; step < 20000; ++step) {
+    std::size_t id{anyId(rng)};
+    int priority{anyPriority(rng)};
+    bool present{priorities[id] >= 0};
+    ASSERT_EQ(heap.contains(id), present);
+    switch (operation(rng)) {
+    case 0:
+    case 1:
+      if (present) {
+        expected.erase({priorities[id], id});
+      }
+      heap.push(id, priority);
+      expected.insert({priority, id});
+      priorities[id] = priority;
+      break;
+    case 2:
+      if (present) {
+        heap.erase(id);
+        expected.erase({priorities[id], id});
+        priorities[id] = -1;
+      }
+      break;
+    default:
+      if (!heap.empty()) {
+        auto [top, topPriority] = heap.pop();
+        EXPECT_EQ(topPriority, expected.begin()->first);
+        expected.erase({topPriority, top});
+        priorities[top] = -1;
+      }
+    }
+    ASSERT_EQ(heap.size(), expected.size());
+  }
+}
+
+TEST(IndexedHeapTest, PriorityQueueBackend) {
+  // timers by id, due times change while they wait
+  IndexedPriorityQueue<long long> timers{};
+  for (std::size_t timer{}; timer < 10; ++timer) {
+    timers.push(timer, static_cast<long long>(100 - timer));
+  }
+  timers.update(0, 1);
+  timers.erase(9);
+  EXPECT_FALSE(timers.contains(9));
+  EXPECT_EQ(timers.top(), 0);
+  EXPECT_EQ(timers.pop().first, 0);
+  EXPECT_EQ(timers.pop().first, 8);
+}
+
+// timers that keep getting rescheduled; Heap has to find the old entry by a
+// linear scan and push a new one
+TEST(PerfTest, Reschedule) {
+  constexpr std::size_t timerCount{20'000};
+  constexpr int reschedules{20'000};
+  std::mt19937 rng{11};
+  std::uniform_int_distribution<std::size_t> anyTimer{0, timerCount - 1};
+  std::uniform_int_distribution<int> anyDue{0, 1 << 20};
+
+  Vector<std::pair<int, std::size_t>> due(timerCount);
+  MinHeap<std::pair<int, std::size_t>> heap{};
+  IndexedHeap<int> indexed{timerCount};
+  for (std::size_t timer{}; timer < timerCount; ++timer) {
+    due.push_back({anyDue(rng), timer});
+    heap.push(due[timer]);
+    indexed.push(timer, due[timer].first);
+  }
+  Vector<std::pair<std::size_t, int>> changes(reschedules);
+  for (int i{}; i < reschedules; ++i) {
+    changes.push_back({anyTimer(rng), anyDue(rng)});
+  }
+
+  Timer timer{};
+  for (auto [id, when] : changes) {
+    heap.remove(due[id]);
+    due[id].first = when;
+    heap.push(due[id]);
+  }
+  double heapTime{timer.elapsed()};
+  timer.reset();
+  for (auto [id, when] : changes) {
+    indexed.update(id, when);
+  }
+  double indexedTime{timer.elapsed()};
+  EXPECT_EQ(heap.top().second, indexed.top());
+  std::cout << timerCount << " TIMERS, " << reschedules
+            << " RESCHEDULES: HEAP " << heapTime << " s, INDEXED HEAP "
+            << indexedTime << " s\n";
+}
@@ -0,0 +1,144 @@
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <intrusive-list.hpp>
+#include <iostream>
+#include <iterator>
+#include <list.hpp>
+#include <timer.hpp>
+#include <vector.hpp>
+
+struct ReadyTag {};
+
+struct Task : IntrusiveListHook<>, IntrusiveListHook<ReadyTag> {
+  int _id{};
+
+  Task() = default;
+  Task(int id) : _id{id} {}
+};
+
+template <typename L>
+void expectIds(const L& l, std::initializer_list<int> ids) {
+  ASSERT_EQ(l.size(), ids.size());
+  auto iter{l.begin()};
+  for (int id : ids) {
+    EXPECT_EQ((iter++)->_id, id);
+  }
+  EXPECT_EQ(iter, l.end());
+}
+
+TEST(IntrusiveListTest, PushPopDoesNotOwn) {
+  Task tasks[]{Task{0}, Task{1}, Task{2}};
+  IntrusiveList<Task> l{};
+  l.push_back(tasks[1]);
+  l.push_back(tasks[2]);
+  l.push_front(tasks[0]);
+  expectIds(l, {0, 1, 2});
+  EXPECT_EQ(&l.front(), &tasks[0]);
+  EXPECT_TRUE(static_cast<IntrusiveListHook<>&>(tasks[0]).is_linked());
+
+  l.pop_front();
+  l.pop_back();
+  expectIds(l, {1});
+  EXPECT_FALSE(static_cast<IntrusiveListHook<>&>(tasks[0]).is_linked());
+  EXPECT_EQ(tasks[2]._id, 2);
+
+  l.remove(tasks[1]);
+  EXPECT_TRUE(l.empty());
+}
+
+TEST(IntrusiveListTest, OneListPerTag) {
+  Task tasks[]{Task{0}, Task{1}, Task{2}, Task{3}};
+  IntrusiveList<Task> all{};
+  IntrusiveList<Task, ReadyTag> ready{};
+  for (Task& task : tasks) {
+    all.push_back(task);
+  }
+  ready.push_back(tasks[3]);
+  ready.push_back(tasks[1]);
+
+  expectIds(all, {0, 1, 2, 3});
+  expectIds(ready, {3, 1});
+
+  auto next{all.erase(all.iterator_to(tasks[1]))};
+  EXPECT_EQ(next->_id, 2);
+  expectIds(all, {0, 2, 3});
+  expectIds(ready, {3, 1});
+  ready.clear();
+}
+
+TEST(IntrusiveListTest, Splice) {
+  Task tasks[]{Task{0}, Task{1}, Task{2}, Task{3}, Task{4}, Task{5}};
+  IntrusiveList<Task> l1{};
+  IntrusiveList<Task> l2{};
+  for (int i{}; i < 3; ++i) {
+    l1.push_back(tasks[i]);
+    l2.push_back(tasks[i + 3]);
+  }
+
+  l1.splice(l1.begin(), l2, std::next(l2.begin()));
+  expectIds(l1, {4, 0, 1, 2});
+  expectIds(l2, {3, 5});
+
+  l2.splice(l2.end(), l1, std::next(l1.begin()), std::prev(l1.end()));
+  expectIds(l1, {4, 2});
+  expectIds(l2, {3, 5, 0, 1});
+
+  l1.splice(std::next(l1.begin()), l2);
+  expectIds(l1, {4, 3, 5, 0, 1, 2});
+  EXPECT_TRUE(l2.empty());
+
+  IntrusiveList<Task> moved{std::move(l1)};
+  EXPECT_TRUE(l1.empty());
+  swap(moved, l2);
+  expectIds(l2, {4, 3, 5, 0, 1, 2});
+  EXPECT_TRUE(moved.empty());
+}
+
+TEST(PerfTest, MoveBetweenQueues) {
+  constexpr int tasks{1000};
+  constexpr int moves{1000000};
+
+  List<Task> ready{};
+  List<Task> waiting{};
+  for (int i{}; i < tasks; ++i) {
+    ready.push_back(Task{i});
+  }
+  Timer timer{};
+  for (int i{}; i < moves; ++i) {
+    waiting.push_back(ready.front());
+    ready.pop_front();
+    if (ready.size() == 0) {
+      ready.swap(waiting);
+    }
+  }
+  std::cout << "LIST POP + PUSH: " << timer.elapsed() << "\n";
+
+  timer.reset();
+  for (int i{}; i < moves; ++i) {
+    waiting.splice(waiting.end(), ready, ready.begin());
+    if (ready.size() == 0) {
+      ready.swap(waiting);
+    }
+  }
+  std::cout << "LIST SPLICE: " << timer.elapsed() << "\n";
+
+  Vector<Task> storage(tasks, Task{});
+  IntrusiveList<Task> intrusiveReady{};
+  IntrusiveList<Task> intrusiveWaiting{};
+  for (Task& task : storage) {
+    intrusiveReady.push_back(task);
+  }
+  timer.reset();
+  for (int i{}; i < moves; ++i) {
+    Task& task{intrusiveReady.front()};
+    intrusiveReady.pop_front();
+    intrusiveWaiting.push_back(task);
+    if (intrusiveReady.empty()) {
+      intrusiveReady.swap(intrusiveWaiting);
+    }
+  }
+  std::cout << "INTRUSIVE LIST: " << timer.elapsed() << "\n";
+  EXPECT_EQ(intrusiveReady.size() + intrusiveWaiting.size(), tasks);
+  intrusiveReady.clear();
+  intrusiveWaiting.clear();
+}
@@ -237,6 +237,70 @@ TEST_F(ListTest, reverseRecursion) {
   }
 }
 
+TEST_F(ListTest, splice) {
+  List<TestObj> l2{TestObj{4}, TestObj{5}, TestObj{6}};
+  l1.splice(l1.end(), l2, l2.begin());
+  EXPECT_EQ(l1.size(), 4);
+  EXPECT_EQ(l2.size(), 2);
+  EXPECT_EQ(l1[3].num(), 4);
+
+  l1.splice(l1.begin(), l2);
+  EXPECT_EQ(l1.size(), 6);
+  EXPECT_EQ(l2.size(), 0);
+  EXPECT_EQ(l2.begin(), l2.end());
+  testListsEq(List<TestObj>{TestObj{5}, TestObj{6}, TestObj{1}, TestObj{2},
+                            TestObj{3}, TestObj{4}},
+              l1);
+
+  List<TestObj>::iterator first{l1.begin()};
+  ++first;
+  List<TestObj>::iterator last{first};
+  ++last;
+  ++last;
+  l2.splice(l2.end(), l1, first, last);
+  testListsEq(List<TestObj>{TestObj{6}, TestObj{1}}, l2);
+  EXPECT_EQ(l1.size(), 4);
+
+  // moving within the same list
+  l1.splice(l1.begin(), l1, --l1.end());
+  testListsEq(List<TestObj>{TestObj{4}, TestObj{5}, TestObj{2}, TestObj{3}},
+              l1);
+}
+
+TEST_F(ListTest, recyclesNodes) {
+  TestObj* lastNode{&l1.back()};
+  l1.pop_back();
+  l1.push_front(TestObj{0});
+  EXPECT_EQ(&l1.front(), lastNode);
+  EXPECT_EQ(l1.front().num(), 0);
+
+  l1.pop_front();
+  EXPECT_EQ(l1.free_nodes(), 1);
+  l1.shrink_to_fit();
+  EXPECT_EQ(l1.free_nodes(), 0);
+  l1.push_back(TestObj{3});
+  EXPECT_EQ(l1.size(), 3);
+  EXPECT_EQ(l1[2].num(), 3);
+}
+
+// a list that once was big does not keep all of its nodes
+TEST(ListFreeNodesTest, FreeListIsCapped) {
+  List<int> l{};
+  for (int i{}; i < 10000; ++i) {
+    l.push_back(i);
+  }
+  while (l.size() > 0) {
+    l.pop_front();
+  }
+  EXPECT_GT(l.free_nodes(), 0);
+  EXPECT_LE(l.free_nodes(), 64);
+  std::size_t kept{l.free_nodes()};
+  for (int i{}; i < 10; ++i) {
+    l.push_back(i);
+  }
+  EXPECT_EQ(l.free_nodes(), kept - 10);
+}
+
 TEST(PerfTest, StdList) {
   Timer t{};
   std::list<TestObj> l1{};
@@ -0,0 +1,133 @@
+#include <atomic>
+#include <cstddef>
+#include <epoch.hpp>
+#include <gtest/gtest.h>
+#include <helpers.hpp>
+#include <iostream>
+#include <lock-free-stack.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stack.hpp>
+#include <thread>
+#include <timer.hpp>
+#include <vector.hpp>
+
+using TestObj = helpers::Test;
+
+TEST(LockFreeStackTest, Lifo) {
+  LockFreeStack<TestObj> stack{};
+  EXPECT_TRUE(stack.empty());
+  EXPECT_FALSE(stack.pop().has_value());
+  for (int i{}; i < 10; ++i) {
+    stack.push(TestObj{i});
+  }
+  TestObj last{10};
+  stack.push(last);
+  EXPECT_FALSE(stack.empty());
+  for (int i{10}; i >= 0; --i) {
+    EXPECT_EQ(stack.pop()->num(), i);
+  }
+  EXPECT_TRUE(stack.empty());
+  stack.push(TestObj{11});
+  // the destructor frees what is left
+}
+
+// pushers and poppers hammer the same stack; every item comes out exactly
+// once, whether it went through the head or the elimination array
+template <std::size_t EliminationSlots> void stress(std::size_t threadCount) {
+  constexpr int perThread{50'000};
+  int items{perThread * static_cast<int>(threadCount)};
+  LockFreeStack<int, Allocator<int>, EliminationSlots> stack{};
+  std::unique_ptr<std::atomic<int>[]> taken{
+      new std::atomic<int>[static_cast<std::size_t>(items)]{}};
+  std::atomic<int> popped{0};
+
+  Vector<std::thread> threads(2 * threadCount);
+  for (std::size_t t{}; t < threadCount; ++t) {
+    threads.push_back(std::thread{[&, t]() {
+      int first{static_cast<int>(t) * perThread};
+      for (int i{first}; i < first + perThread; ++i) {
+        stack.push(i);
+      }
+    }});
+    threads.push_back(std::thread{[&]() {
+      while (popped.load() < items) {
+        if (std::optional<int> item{stack.pop()}) {
+          taken[static_cast<std::size_t>(*item)].fetch_add(1);
+          popped.fetch_add(1);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }});
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(stack.empty());
+  for (int i{}; i < items; ++i) {
+    ASSERT_EQ(taken[static_cast<std::size_t>(i)].load(), 1) << "item " << i;
+  }
+  epoch::reclaim();
+}
+
+TEST(LockFreeStackTest, Stress) { stress<16>(4); }
+
+TEST(LockFreeStackTest, StressWithoutElimination) { stress<0>(4); }
+
+// Stack behind a mutex, what the lock-free stack replaces
+template <typename T> struct LockedStack {
+  std::mutex _mutex{};
+  Stack<T> _stack{};
+
+  void push(T value) {
+    std::lock_guard lock{_mutex};
+    _stack.push(value);
+  }
+
+  std::optional<T> pop() {
+    std::lock_guard lock{_mutex};
+    if (_stack.empty()) {
+      return std::nullopt;
+    }
+    return _stack.pop();
+  }
+};
+
+// every thread pushes and pops in turns, the way threads share a free list
+template <typename S> double throughput(S& stack, std::size_t threadCount) {
+  constexpr int perThread{200'000};
+  Timer timer{};
+  Vector<std::thread> threads(threadCount);
+  for (std::size_t t{}; t < threadCount; ++t) {
+    threads.push_back(std::thread{[&]() {
+      for (int i{}; i < perThread; ++i) {
+        stack.push(i);
+        stack.pop();
+      }
+    }});
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  return static_cast<double>(2 * perThread) *
+         static_cast<double>(threadCount) / timer.elapsed();
+}
+
+TEST(PerfTest, StackContention) {
+  constexpr std::size_t threadCounts[]{1, 2, 4, 8, 16};
+  for (std::size_t threadCount : threadCounts) {
+    LockedStack<int> locked{};
+    double lockedRate{throughput(locked, threadCount)};
+    LockFreeStack<int, Allocator<int>, 0> plain{};
+    double plainRate{throughput(plain, threadCount)};
+    LockFreeStack<int> eliminating{};
+    double eliminatingRate{throughput(eliminating, threadCount)};
+    std::cout << threadCount << " THREADS: MUTEX STACK " << lockedRate
+              << " ops/s, TREIBER " << plainRate
+              << " ops/s, TREIBER + ELIMINATION " << eliminatingRate
+              << " ops/s\n";
+  }
+  epoch::reclaim();
+}
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <circular-buffer.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <magic-circular-buffer.hpp>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <timer.hpp>
+#include <unistd.h>
+#include <vector.hpp>
+
+TEST(MagicCircularBufferTest, RoundsUpToPages) {
+  MagicCircularBuffer<int> buffer{10};
+  EXPECT_EQ(buffer.capacity() * sizeof(int) %
+                static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)),
+            0);
+  EXPECT_GE(buffer.capacity(), 10);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.write_span().size(), buffer.capacity());
+}
+
+TEST(MagicCircularBufferTest, SpansStayContiguousAcrossTheWrap) {
+  MagicCircularBuffer<int> buffer{1};
+  std::size_t capacity{buffer.capacity()};
+
+  // move the head close to the end of the storage
+  buffer.commit(capacity - 3);
+  buffer.consume(capacity - 3);
+  for (int i{}; i < 8; ++i) {
+    buffer.push_back(i);
+  }
+  EXPECT_EQ(buffer.size(), 8);
+
+  // the last 5 elements sit at the start of the pages, seen through the
+  // mirror they still follow the first 3
+  std::span<int> elements{buffer.read_span()};
+  ASSERT_EQ(elements.size(), 8);
+  for (int i{}; i < 8; ++i) {
+    EXPECT_EQ(elements[static_cast<std::size_t>(i)], i);
+    EXPECT_EQ(buffer[static_cast<std::size_t>(i)], i);
+  }
+  EXPECT_EQ(std::accumulate(buffer.begin(), buffer.end(), 0), 28);
+  EXPECT_EQ(buffer.front(), 0);
+  EXPECT_EQ(buffer.back(), 7);
+  EXPECT_THROW(buffer.at(8), MagicCircularBuffer<int>::OutOfRangeException);
+
+  std::span<int> free{buffer.write_span()};
+  EXPECT_EQ(free.size(), capacity - 8);
+  EXPECT_EQ(free.data(), elements.data() + 8);
+  free[0] = 8;
+  buffer.commit(1);
+  EXPECT_EQ(buffer.back(), 8);
+
+  buffer.consume(5);
+  EXPECT_EQ(buffer.pop_front(), 5);
+  EXPECT_EQ(buffer.size(), 3);
+  EXPECT_EQ(buffer.front(), 6);
+}
+
+TEST(MagicCircularBufferTest, PushSpanAndMove) {
+  MagicCircularBuffer<char> buffer{1};
+  std::size_t capacity{buffer.capacity()};
+  std::string_view text{"hello ring"};
+  EXPECT_EQ(buffer.push_back(std::span{text}), text.size());
+
+  MagicCircularBuffer<char> moved{std::move(buffer)};
+  EXPECT_EQ(moved.size(), text.size());
+  EXPECT_EQ(std::string_view(moved.read_span().data(), moved.size()), text);
+
+  Vector<char> filler(capacity, 'x');
+  EXPECT_EQ(moved.push_back(std::span{filler.data(), filler.size()}),
+            capacity - text.size());
+  EXPECT_TRUE(moved.is_full());
+  EXPECT_THROW(moved.push_back('y'), std::runtime_error);
+}
+
+TEST(MagicCircularBufferTest, CommitAndConsumeAreChecked) {
+  using Buffer = MagicCircularBuffer<char>;
+  Buffer buffer{1};
+  std::size_t capacity{buffer.capacity()};
+  buffer.commit(10);
+  EXPECT_THROW(buffer.commit(capacity - 9), Buffer::OutOfRangeException);
+  // a failed read() returning -1 must not pass for a huge count
+  EXPECT_THROW(buffer.commit(static_cast<std::size_t>(-1)),
+               Buffer::OutOfRangeException);
+  EXPECT_THROW(buffer.consume(11), Buffer::OutOfRangeException);
+  EXPECT_EQ(buffer.size(), 10);
+  buffer.commit(capacity - 10);
+  EXPECT_TRUE(buffer.is_full());
+  buffer.consume(capacity);
+  EXPECT_TRUE(buffer.empty());
+}
+
+// read() and write() go straight into and out of the buffer, even when the
+// data wraps around
+TEST(MagicCircularBufferTest, SyscallsWorkInPlace) {
+  int pipeFds[2]{};
+  ASSERT_EQ(::pipe(pipeFds), 0);
+  MagicCircularBuffer<char> buffer{1};
+  std::size_t capacity{buffer.capacity()};
+  buffer.commit(capacity - 4);
+  buffer.consume(capacity - 4);
+
+  std::string_view message{"across the wrap"};
+  ASSERT_EQ(::write(pipeFds[1], message.data(), message.size()),
+            static_cast<ssize_t>(message.size()));
+  std::span<char> free{buffer.write_span()};
+  ssize_t got{::read(pipeFds[0], free.data(), free.size())};
+  ASSERT_EQ(got, static_cast<ssize_t>(message.size()));
+  buffer.commit(static_cast<std::size_t>(got));
+
+  std::span<char> full{buffer.read_span()};
+  ASSERT_EQ(::write(pipeFds[1], full.data(), full.size()),
+            static_cast<ssize_t>(full.size()));
+  buffer.consume(full.size());
+  char echoed[32]{};
+  ASSERT_EQ(::read(pipeFds[0], echoed, sizeof(echoed)),
+            static_cast<ssize_t>(message.size()));
+  EXPECT_EQ(std::string_view(echoed, message.size()), message);
+  EXPECT_TRUE(buffer.empty());
+  ::close(pipeFds[0]);
+  ::close(pipeFds[1]);
+}
+
+// streams chunks through a buffer that is always partly full, so most
+// chunks wrap. CircularBuffer copies element by element around the wrap,
+// the magic buffer copies each chunk with one memcpy.
+TEST(PerfTest, MagicCircularBufferStream) {
+  constexpr std::size_t capacity{64 * 1024};
+  constexpr std::size_t chunk{1000};
+  constexpr int rounds{20'000};
+  Vector<char> in(chunk, 'a');
+  Vector<char> out(chunk, 'b');
+  long long sum{};
+
+  CircularBuffer<char, capacity> ring{};
+  for (std::size_t i{}; i < capacity / 2; ++i) {
+    ring.push_back('c');
+  }
+  Timer timer{};
+  for (int round{}; round < rounds; ++round) {
+    for (char c : in) {
+      ring.push_back(c);
+    }
+    for (char& c : out) {
+      c = ring.pop_front();
+    }
+    sum += out[chunk - 1];
+  }
+  std::cout << "CIRCULAR BUFFER: " << timer.elapsed() << "\n";
+
+  MagicCircularBuffer<char> magic{capacity};
+  Vector<char> half(capacity / 2, 'c');
+  magic.push_back(std::span{half.data(), half.size()});
+  timer.reset();
+  for (int round{}; round < rounds; ++round) {
+    magic.push_back(std::span{in.data(), in.size()});
+    std::copy_n(magic.read_span().data(), chunk, out.begin());
+    magic.consume(chunk);
+    sum -= out[chunk - 1];
+  }
+  std::cout << "MAGIC CIRCULAR BUFFER: " << timer.elapsed() << "\n";
+  EXPECT_EQ(sum, 0);
+}
@@ -0,0 +1,174 @@
+#include <algorithm.hpp>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <mapped-vector.hpp>
+#include <math.hpp>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <timer.hpp>
+#include <unistd.h>
+#include <vector.hpp>
+
+class MappedVectorTest : public ::testing::Test {
+protected:
+  std::string _path{
+      "/tmp/mapped-vector-" + std::to_string(::getpid()) + "-" +
+      ::testing::UnitTest::GetInstance()->current_test_info()->name()};
+
+  void TearDown() override { std::remove(_path.c_str()); }
+};
+
+struct Tick {
+  int id;
+  double price;
+};
+
+TEST_F(MappedVectorTest, GrowsAndReloads) {
+  {
+    MappedVector<int> v{_path};
+    EXPECT_TRUE(v.empty());
+    for (int i{}; i < 100000; ++i) {
+      v.push_back(i);
+    }
+    EXPECT_EQ(v.size(), 100000);
+    EXPECT_GE(v.capacity(), 100000);
+    EXPECT_EQ(v.back(), 99999);
+    EXPECT_EQ(v.pop_back(), 99999);
+  }
+  // the data is still there when the file is opened again
+  MappedVector<int> reloaded{_path};
+  ASSERT_EQ(reloaded.size(), 99999);
+  for (std::size_t i{}; i < reloaded.size(); ++i) {
+    EXPECT_EQ(reloaded[i], static_cast<int>(i));
+  }
+  EXPECT_THROW(reloaded.at(99999), MappedVector<int>::OutOfRangeException);
+
+  // element size is checked, before anything touches the file
+  struct stat before {};
+  ASSERT_EQ(::stat(_path.c_str(), &before), 0);
+  EXPECT_THROW(MappedVector<double>{_path}, std::system_error);
+  struct stat after {};
+  ASSERT_EQ(::stat(_path.c_str(), &after), 0);
+  EXPECT_EQ(after.st_size, before.st_size);
+  MappedVector<int> again{_path};
+  ASSERT_EQ(again.size(), 99999);
+  for (std::size_t i{}; i < again.size(); ++i) {
+    ASSERT_EQ(again[i], static_cast<int>(i));
+  }
+}
+
+// a file that is not a MappedVector is left as it was
+TEST_F(MappedVectorTest, RejectsForeignFiles) {
+  {
+    std::ofstream foreign{_path, std::ios::binary};
+    foreign << std::string(100, 'x');
+  }
+  EXPECT_THROW(MappedVector<int>{_path}, std::system_error);
+  struct stat info {};
+  ASSERT_EQ(::stat(_path.c_str(), &info), 0);
+  EXPECT_EQ(info.st_size, 100);
+}
+
+TEST_F(MappedVectorTest, AppendAndSort) {
+  Vector<int> primes{math::find_prime_segmented(1000)};
+  MappedVector<int> v{_path};
+  v.append(primes.begin(), primes.end());
+  ASSERT_EQ(v.size(), primes.size());
+  EXPECT_EQ(v[0], 2);
+
+  std::reverse(v.begin(), v.end());
+  algorithms::sort::quicksort(v.begin(), v.end());
+  for (std::size_t i{}; i < v.size(); ++i) {
+    EXPECT_EQ(v[i], primes[i]);
+  }
+
+  int* raw{v.append_uninitialized(2)};
+  raw[0] = 1;
+  raw[1] = 0;
+  algorithms::sort::insertion_sort(v.end() - 3, v.end());
+  EXPECT_EQ(v[v.size() - 2], 1);
+  EXPECT_EQ(v.back(), primes.back());
+}
+
+TEST_F(MappedVectorTest, StructsAndResize) {
+  MappedVector<Tick> v{_path, 10};
+  EXPECT_GE(v.capacity(), 10);
+  v.emplace_back(1, 1.5);
+  v.resize(5, {2, 2.5});
+  EXPECT_EQ(v.size(), 5);
+  EXPECT_EQ(v[0].price, 1.5);
+  EXPECT_EQ(v[4].id, 2);
+  v.resize(1);
+  v.shrink_to_fit();
+  EXPECT_EQ(v.size(), 1);
+
+  MappedVector<Tick> moved{std::move(v)};
+  EXPECT_EQ(moved.front().id, 1);
+  moved.clear();
+  EXPECT_TRUE(moved.empty());
+}
+
+// bytes of address space the process uses now
+std::size_t addressSpace() {
+  std::size_t pages{};
+  std::ifstream{"/proc/self/statm"} >> pages;
+  return pages * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+TEST_F(MappedVectorTest, FailedGrowthKeepsData) {
+  MappedVector<int> v{_path};
+  for (int i{}; i < 1000; ++i) {
+    v.push_back(i);
+  }
+  std::size_t capacity{v.capacity()};
+
+  // leave no room for a 16 GiB mapping
+  rlimit old{};
+  ASSERT_EQ(::getrlimit(RLIMIT_AS, &old), 0);
+  rlimit capped{old};
+  capped.rlim_cur = addressSpace() + (std::size_t{64} << 20);
+  ASSERT_EQ(::setrlimit(RLIMIT_AS, &capped), 0);
+  EXPECT_THROW(v.reserve(std::size_t{1} << 32), std::system_error);
+  ASSERT_EQ(::setrlimit(RLIMIT_AS, &old), 0);
+
+  EXPECT_EQ(v.capacity(), capacity);
+  ASSERT_EQ(v.size(), 1000);
+  for (std::size_t i{}; i < v.size(); ++i) {
+    EXPECT_EQ(v[i], static_cast<int>(i));
+  }
+  // the file went back to its old length
+  struct stat info {};
+  ASSERT_EQ(::stat(_path.c_str(), &info), 0);
+  EXPECT_LT(static_cast<std::size_t>(info.st_size), std::size_t{1} << 20);
+  v.push_back(1000);
+  EXPECT_EQ(v.back(), 1000);
+}
+
+TEST_F(MappedVectorTest, PerfTest) {
+  constexpr std::size_t count{10'000'000};
+  Timer timer{};
+  {
+    Vector<double> v{};
+    for (std::size_t i{}; i < count; ++i) {
+      v.push_back(static_cast<double>(i));
+    }
+  }
+  std::cout << "VECTOR: " << timer.elapsed() << "\n";
+
+  timer.reset();
+  {
+    MappedVector<double> v{_path};
+    for (std::size_t i{}; i < count; ++i) {
+      v.push_back(static_cast<double>(i));
+    }
+  }
+  std::cout << "MAPPED VECTOR: " << timer.elapsed() << "\n";
+
+  timer.reset();
+  MappedVector<double> reloaded{_path};
+  std::cout << "MAPPED VECTOR RELOAD: " << timer.elapsed() << "\n";
+  EXPECT_EQ(reloaded.size(), count);
+}
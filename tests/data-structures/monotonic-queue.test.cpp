@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <monotonic-queue.hpp>
+#include <numeric>
+#include <random.hpp>
+#include <set>
+#include <static-circular-buffer.hpp>
+#include <string>
+#include <timer.hpp>
+
+struct Gcd {
+  int operator()(int a, int b) const { return std::gcd(a, b); }
+};
+
+TEST(MonotonicQueueTest, MinAndMaxOverAWindow) {
+  MonotonicQueue<int> min{3};
+  MonotonicQueue<int, std::greater<int>> max{3};
+  int values[]{5, 3, 4, 3, 8, 9, 1, 7};
+  int mins[]{5, 3, 3, 3, 3, 3, 1, 1};
+  int maxes[]{5, 5, 5, 4, 8, 9, 9, 9};
+  for (std::size_t i{}; i < 8; ++i) {
+    min.push(values[i]);
+    max.push(values[i]);
+    EXPECT_EQ(min.min(), mins[i]) << "after " << i;
+    EXPECT_EQ(max.min(), maxes[i]) << "after " << i;
+  }
+  EXPECT_EQ(min.size(), 3);
+  EXPECT_EQ(min.front(), 9);
+  EXPECT_EQ(min.back(), 7);
+  EXPECT_EQ(min.pop(), 9);
+  EXPECT_EQ(min.pop(), 1);
+  EXPECT_EQ(min.min(), 7);
+}
+
+// random pushes and pops, duplicates included, against a multiset
+template <typename Queue> void matchesMultiset(Queue queue) {
+  std::deque<int> window{};
+  std::multiset<int> sorted{};
+  for (int i{}; i < 20000; ++i) {
+    if (!window.empty() && Random::uniformRand(0, 2) == 0) {
+      EXPECT_EQ(queue.pop(), window.front());
+      sorted.erase(sorted.find(window.front()));
+      window.pop_front();
+    } else {
+      int value{Random::uniformRand(0, 20)};
+      if (queue.window() && window.size() == queue.window()) {
+        sorted.erase(sorted.find(window.front()));
+        window.pop_front();
+      }
+      queue.push(value);
+      window.push_back(value);
+      sorted.insert(value);
+    }
+    ASSERT_EQ(queue.size(), window.size());
+    if (!window.empty()) {
+      ASSERT_EQ(queue.min(), *sorted.begin());
+    }
+  }
+}
+
+TEST(MonotonicQueueTest, MatchesMultiset) {
+  matchesMultiset(MonotonicQueue<int>{});
+  matchesMultiset(MonotonicQueue<int>{16});
+  matchesMultiset(
+      MonotonicQueue<int, std::less<int>, StaticCircularBuffer<int, 16>>{16});
+}
+
+TEST(AggregateQueueTest, FoldsAnyAssociativeOperation) {
+  AggregateQueue<long, std::plus<long>> sum{4};
+  AggregateQueue<int, Gcd> gcd{3};
+  int values[]{12, 18, 24, 9, 27, 81, 54, 7};
+  long sums[]{12, 30, 54, 63, 78, 141, 171, 169};
+  int gcds[]{12, 6, 6, 3, 3, 9, 27, 1};
+  for (std::size_t i{}; i < 8; ++i) {
+    sum.push(values[i]);
+    gcd.push(values[i]);
+    EXPECT_EQ(sum.aggregate(), sums[i]) << "after " << i;
+    EXPECT_EQ(gcd.aggregate(), gcds[i]) << "after " << i;
+  }
+  EXPECT_EQ(sum.front(), 27);
+  EXPECT_EQ(sum.back(), 7);
+  EXPECT_EQ(sum.pop(), 27);
+  EXPECT_EQ(sum.aggregate(), 142);
+}
+
+TEST(AggregateQueueTest, KeepsOrderForNonCommutativeOperations) {
+  AggregateQueue<std::string, std::plus<std::string>> text{};
+  text.push("a");
+  text.push("b");
+  text.push("c");
+  EXPECT_EQ(text.aggregate(), "abc");
+  EXPECT_EQ(text.pop(), "a");
+  text.push("d");
+  EXPECT_EQ(text.aggregate(), "bcd");
+  text.pop();
+  text.pop();
+  text.push("e");
+  EXPECT_EQ(text.aggregate(), "de");
+  EXPECT_EQ(text.front(), "d");
+  EXPECT_EQ(text.back(), "e");
+}
+
+// a deterministic, jumpy telemetry series
+int sample(int i) { return static_cast<int>(i * 7919LL % 10007); }
+
+TEST(PerfTest, RollingMin) {
+  constexpr int samples{5'000'000};
+  constexpr std::size_t window{1000};
+  long long sum{};
+
+  std::deque<int> fifo{};
+  std::multiset<int> sorted{};
+  Timer timer{};
+  for (int i{}; i < samples; ++i) {
+    int value{sample(i)};
+    if (fifo.size() == window) {
+      sorted.erase(sorted.find(fifo.front()));
+      fifo.pop_front();
+    }
+    fifo.push_back(value);
+    sorted.insert(value);
+    sum += *sorted.begin();
+  }
+  std::cout << "MULTISET ROLLING MIN: " << timer.elapsed() << "\n";
+
+  MonotonicQueue<int> min{window};
+  timer.reset();
+  for (int i{}; i < samples; ++i) {
+    min.push(sample(i));
+    sum -= min.min();
+  }
+  std::cout << "MONOTONIC QUEUE ROLLING MIN: " << timer.elapsed() << "\n";
+  EXPECT_EQ(sum, 0);
+
+  AggregateQueue<long long, std::plus<long long>> total{window};
+  timer.reset();
+  for (int i{}; i < samples; ++i) {
+    total.push(sample(i));
+    sum += total.aggregate();
+  }
+  std::cout << "AGGREGATE QUEUE ROLLING SUM: " << timer.elapsed() << "\n";
+  EXPECT_GT(sum, 0);
+}
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <helpers.hpp>
+#include <iostream>
+#include <memory>
+#include <mpmc-circular-buffer.hpp>
+#include <optional>
+#include <thread>
+#include <timer.hpp>
+#include <tracking-allocator.hpp>
+#include <vector.hpp>
+
+using namespace std::chrono_literals;
+using TestObj = helpers::Test;
+
+TEST(MpmcCircularBufferTest, PushPopWrapAround) {
+  MpmcCircularBuffer<TestObj, 3> buffer{};
+  EXPECT_EQ(buffer.capacity(), 3);
+  EXPECT_FALSE(buffer.try_pop_front().has_value());
+  for (int i{}; i < 3; ++i) {
+    EXPECT_TRUE(buffer.try_push_back(TestObj{i}));
+  }
+  EXPECT_TRUE(buffer.is_full());
+  TestObj extra{3};
+  EXPECT_FALSE(buffer.try_push_back(std::move(extra)));
+  EXPECT_EQ(extra.num(), 3);
+
+  for (int i{3}; i < 50; ++i) {
+    EXPECT_EQ(buffer.pop_front().num(), i - 3);
+    buffer.push_back(TestObj{i});
+  }
+  EXPECT_EQ(buffer.size(), 3);
+  EXPECT_EQ(buffer.try_pop_front()->num(), 47);
+  // the destructor cleans up the other two
+}
+
+TEST(MpmcCircularBufferTest, TimedCallsGiveUp) {
+  MpmcCircularBuffer<int, 2> buffer{};
+  EXPECT_FALSE(buffer.try_pop_front_for(5ms).has_value());
+  EXPECT_TRUE(buffer.try_push_back_for(1, 5ms));
+  EXPECT_TRUE(buffer.try_push_back_for(2, 5ms));
+  EXPECT_FALSE(buffer.try_push_back_for(3, 5ms));
+
+  std::thread consumer{[&]() {
+    std::this_thread::sleep_for(5ms);
+    buffer.pop_front();
+  }};
+  EXPECT_TRUE(buffer.try_push_back_for(3, 10s));
+  consumer.join();
+  EXPECT_EQ(buffer.try_pop_front_for(5ms), 2);
+  EXPECT_EQ(buffer.try_pop_front_for(5ms), 3);
+}
+
+struct MpmcPool {
+  static constexpr const char name[]{"MPMC buffer"};
+};
+
+TEST(MpmcCircularBufferTest, UsesAllocator) {
+  using Tracked = TrackingAllocator<TestObj, MpmcPool>;
+  {
+    MpmcCircularBuffer<TestObj, 8, Tracked> buffer{};
+    EXPECT_EQ(Tracked::stats().allocations, 1);
+    buffer.push_back(TestObj{1});
+  }
+  EXPECT_EQ(Tracked::stats().allocations, Tracked::stats().deallocations);
+}
+
+// every item pushed by the producers is popped exactly once
+TEST(MpmcCircularBufferTest, ManyProducersManyConsumers) {
+  constexpr std::size_t producers{4};
+  constexpr std::size_t consumers{4};
+  constexpr int perProducer{50'000};
+  constexpr int items{perProducer * static_cast<int>(producers)};
+  MpmcCircularBuffer<int, 64> buffer{};
+  std::unique_ptr<std::atomic<int>[]> taken{
+      new std::atomic<int>[static_cast<std::size_t>(items)]{}};
+
+  Vector<std::thread> threads(producers + consumers);
+  for (std::size_t p{}; p < producers; ++p) {
+    threads.push_back(std::thread{[&, p]() {
+      int first{static_cast<int>(p) * perProducer};
+      for (int i{first}; i < first + perProducer; ++i) {
+        buffer.push_back(i);
+      }
+    }});
+  }
+  std::atomic<int> popped{0};
+  for (std::size_t c{}; c < consumers; ++c) {
+    threads.push_back(std::thread{[&]() {
+      while (popped.load() < items) {
+        if (std::optional<int> item{buffer.try_pop_front_for(1ms)}) {
+          taken[static_cast<std::size_t>(*item)].fetch_add(1);
+          popped.fetch_add(1);
+        }
+      }
+    }});
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(buffer.empty());
+  for (int i{}; i < items; ++i) {
+    ASSERT_EQ(taken[static_cast<std::size_t>(i)].load(), 1) << "item " << i;
+  }
+}
+
+// n producers push timestamps, n consumers pop them. Reports the operations
+// (pushes + pops) per second and the 99th percentile of the time an item
+// spent between push and pop.
+TEST(PerfTest, MpmcContention) {
+  constexpr int perProducer{50'000};
+  constexpr std::size_t threadCounts[]{1, 2, 4, 8, 16, 32};
+  using Clock = std::chrono::steady_clock;
+
+  for (std::size_t n : threadCounts) {
+    MpmcCircularBuffer<Clock::time_point, 1024> buffer{};
+    Vector<Vector<long long>> latencies(n);
+    for (std::size_t i{}; i < n; ++i) {
+      latencies.push_back(Vector<long long>(perProducer));
+    }
+
+    Timer timer{};
+    Vector<std::thread> threads(2 * n);
+    for (std::size_t i{}; i < n; ++i) {
+      threads.push_back(std::thread{[&]() {
+        for (int j{}; j < perProducer; ++j) {
+          buffer.push_back(Clock::now());
+        }
+      }});
+      // each consumer pops as many as a producer pushes
+      threads.push_back(std::thread{[&, i]() {
+        for (int j{}; j < perProducer; ++j) {
+          Clock::time_point pushed{buffer.pop_front()};
+          latencies[i].push_back(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  Clock::now() - pushed)
+                  .count());
+        }
+      }});
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    double elapsed{timer.elapsed()};
+
+    Vector<long long> all(n * perProducer);
+    for (Vector<long long>& consumer : latencies) {
+      for (long long latency : consumer) {
+        all.push_back(latency);
+      }
+    }
+    double ops{2.0 * static_cast<double>(all.size())};
+    auto p99{all.begin() + static_cast<std::ptrdiff_t>(all.size() / 100 * 99)};
+    std::nth_element(all.begin(), p99, all.end());
+    std::cout << n << " PRODUCERS / " << n << " CONSUMERS: " << ops / elapsed
+              << " ops/s, p99 " << *p99 << " ns\n";
+    EXPECT_TRUE(buffer.empty());
+  }
+}
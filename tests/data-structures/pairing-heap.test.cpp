@@ -0,0 +1,204 @@
+#include <cstddef>
+#include <fibonacci-heap.hpp>
+#include <functional>
+#include <gtest/gtest.h>
+#include <helpers.hpp>
+#include <iostream>
+#include <pairing-heap.hpp>
+#include <pool-allocator.hpp>
+#include <random>
+#include <set>
+#include <timer.hpp>
+#include <utility>
+#include <vector.hpp>
+
+TEST(PairingHeapTest, InsertExtractDecreaseErase) {
+  PairingHeap<int, helpers::Test> heap{};
+  EXPECT_EQ(heap.top(), nullptr);
+  auto five = heap.insert(5, helpers::Test{5});
+  auto two = heap.insert(2, helpers::Test{2});
+  auto nine = heap.insert(9, helpers::Test{9});
+  heap.insert(7, helpers::Test{7});
+  EXPECT_EQ(heap.size(), 4);
+  EXPECT_EQ(heap.top()->num(), 2);
+
+  heap.decrease_key(nine, 1);
+  EXPECT_EQ(heap.top()->num(), 9);
+  EXPECT_EQ(nine.key(), 1);
+  // not smaller, ignored
+  heap.decrease_key(five, 6);
+  EXPECT_EQ(five.key(), 5);
+
+  heap.erase(two);
+  EXPECT_EQ(heap.size(), 3);
+  EXPECT_EQ(heap.extract_top().first, 1);
+  // the top itself can be erased
+  heap.erase(five);
+  auto [key, value] = heap.extract_top();
+  EXPECT_EQ(key, 7);
+  EXPECT_EQ(value.num(), 7);
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(PairingHeapTest, MergeCopyMove) {
+  PairingHeap<int, int, std::greater_equal<int>> first{};
+  PairingHeap<int, int, std::greater_equal<int>> second{};
+  for (int i{}; i < 10; ++i) {
+    first.insert(i * 2, i);
+    second.insert(i * 2 + 1, i);
+  }
+  auto handle = second.insert(100, -1);
+  first.merge(std::move(second));
+  EXPECT_TRUE(second.empty());
+  EXPECT_EQ(first.size(), 21);
+  // handles from second now refer into first
+  first.erase(handle);
+
+  PairingHeap<int, int, std::greater_equal<int>> copy{first};
+  PairingHeap<int, int, std::greater_equal<int>> moved{std::move(first)};
+  EXPECT_TRUE(first.empty());
+  for (int key{19}; key >= 0; --key) {
+    EXPECT_EQ(copy.extract_top().first, key);
+    EXPECT_EQ(moved.extract_top().first, key);
+  }
+  EXPECT_TRUE(copy.empty());
+}
+
+// random inserts, decrease_keys, erases and extracts against a multiset.
+// Values are ids, so an extracted element can be told apart from its handle
+template <typename Heap> void matchesMultiset() {
+  std::mt19937 rng{7};
+  std::uniform_int_distribution<int> anyKey{0, 100000};
+  std::uniform_int_distribution<int> operation{0, 3};
+  Heap heap{};
+  Vector<typename Heap::Handle> handles{};
+  // ids still in the heap, and where each id sits in live
+  Vector<int> live{};
+  Vector<std::size_t> positions{};
+  std::multiset<int> expected{};
+  auto forget = [&](int id) {
+    std::size_t position{positions[static_cast<std::size_t>(id)]};
+    live[position] = live.back();
+    positions[static_cast<std::size_t>(live[position])] = position;
+    live.pop_back();
+  };
+  for (int step{}; step < 30000; ++step) {
+    int op{live.empty() ? 0 : operation(rng)};
+    int id{live.empty() ? 0 : live[rng() % live.size()]};
+    typename Heap::Handle handle{live.empty()
+                                     ? typename Heap::Handle{}
+                                     : handles[static_cast<std::size_t>(id)]};
+    switch (op) {
+    case 0: {
+      int key{anyKey(rng)};
+      int newId{static_cast<int>(handles.size())};
+      handles.push_back(heap.insert(key, newId));
+      positions.push_back(live.size());
+      live.push_back(newId);
+      expected.insert(key);
+      break;
+    }
+    case 1: {
+      int key{handle.key()};
+      int lower{key - anyKey(rng) % 1000};
+      expected.erase(expected.find(key));
+      expected.insert(lower);
+      heap.decrease_key(handle, lower);
+      ASSERT_EQ(handle.key(), lower);
+      break;
+    }
+    case 2:
+      expected.erase(expected.find(handle.key()));
+      heap.erase(handle);
+      forget(id);
+      break;
+    default: {
+      auto [key, topId] = heap.extract_top();
+      ASSERT_EQ(key, *expected.begin());
+      expected.erase(expected.begin());
+      forget(topId);
+    }
+    }
+    ASSERT_EQ(heap.size(), expected.size());
+  }
+  for (int key : expected) {
+    ASSERT_EQ(heap.extract_top().first, key);
+  }
+}
+
+TEST(PairingHeapTest, MatchesMultiset) {
+  matchesMultiset<PairingHeap<int, int>>();
+}
+
+TEST(PairingHeapTest, NodePool) {
+  matchesMultiset<
+      PairingHeap<int, int, std::less_equal<int>, PoolAllocator<int>>>();
+}
+
+// every round inserts, decreases random keys inserted in that round, then
+// extracts, the way a shortest path search mixes them
+template <typename Heap>
+double mixedWorkload(std::size_t rounds, std::size_t inserts,
+                     std::size_t decreases, std::size_t extracts,
+                     long long& checksum) {
+  std::mt19937 rng{23};
+  std::uniform_int_distribution<int> anyKey{0, 1 << 30};
+  Heap heap{};
+  Vector<typename Heap::Handle> handles{};
+  Timer timer{};
+  for (std::size_t round{}; round < rounds; ++round) {
+    for (std::size_t i{}; i < inserts; ++i) {
+      handles.push_back(heap.insert(anyKey(rng), 0));
+    }
+    // only handles of this round are sure to be live
+    std::size_t first{handles.size() - inserts};
+    for (std::size_t i{}; i < decreases; ++i) {
+      typename Heap::Handle handle{handles[first + rng() % inserts]};
+      heap.decrease_key(handle, handle.key() / 2);
+    }
+    for (std::size_t i{}; i < extracts && !heap.empty(); ++i) {
+      checksum += heap.extract_top().first;
+    }
+  }
+  while (!heap.empty()) {
+    checksum += heap.extract_top().first;
+  }
+  return timer.elapsed();
+}
+
+TEST(PerfTest, PairingVsFibonacci) {
+  using Fibonacci = FibonacciHeap<int, int>;
+  using Pairing = PairingHeap<int, int>;
+  using PooledPairing =
+      PairingHeap<int, int, std::less_equal<int>, PoolAllocator<int>>;
+  struct Workload {
+    const char* name;
+    std::size_t rounds;
+    std::size_t inserts;
+    std::size_t decreases;
+    std::size_t extracts;
+  };
+  // extracts below inserts leave the heap growing, so later rounds work
+  // on a large heap
+  constexpr Workload workloads[]{
+      {"INSERT THEN EXTRACT", 1, 1'000'000, 0, 1'000'000},
+      {"DECREASE HEAVY", 100, 10'000, 40'000, 5'000},
+      {"EXTRACT HEAVY", 1000, 1'000, 500, 900},
+  };
+  for (const Workload& w : workloads) {
+    long long fibonacciSum{};
+    long long pairingSum{};
+    long long pooledSum{};
+    double fibonacciTime{mixedWorkload<Fibonacci>(
+        w.rounds, w.inserts, w.decreases, w.extracts, fibonacciSum)};
+    double pairingTime{mixedWorkload<Pairing>(
+        w.rounds, w.inserts, w.decreases, w.extracts, pairingSum)};
+    double pooledTime{mixedWorkload<PooledPairing>(
+        w.rounds, w.inserts, w.decreases, w.extracts, pooledSum)};
+    EXPECT_EQ(fibonacciSum, pairingSum);
+    EXPECT_EQ(fibonacciSum, pooledSum);
+    std::cout << w.name << ": FIBONACCI HEAP " << fibonacciTime
+              << " s, PAIRING HEAP " << pairingTime
+              << " s, PAIRING HEAP WITH POOL " << pooledTime << " s\n";
+  }
+}
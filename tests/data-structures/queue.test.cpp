@@ -0,0 +1,157 @@
+#include <cstddef>
+#include <deque>
+#include <gtest/gtest.h>
+#include <helpers.hpp>
+#include <iostream>
+#include <iterator>
+#include <queue.hpp>
+#include <queue>
+#include <random.hpp>
+#include <timer.hpp>
+#include <vector.hpp>
+
+using TestObj = helpers::Test;
+
+template <typename Q>
+void expectNums(const Q& q, std::initializer_list<int> nums) {
+  ASSERT_EQ(q.size(), nums.size());
+  std::size_t index{};
+  for (int num : nums) {
+    EXPECT_EQ(q[index++].num(), num);
+  }
+}
+
+TEST(QueueTest, WrapsAroundWithoutGrowing) {
+  Queue<TestObj> q(4);
+  for (int i{}; i < 3; ++i) {
+    q.push_back(TestObj{i});
+  }
+  for (int i{3}; i < 100; ++i) {
+    EXPECT_EQ(q.pop_front().num(), i - 3);
+    q.push_back(TestObj{i});
+  }
+  EXPECT_EQ(q.capacity(), 4);
+  expectNums(q, {97, 98, 99});
+  EXPECT_EQ(q.front().num(), 97);
+  EXPECT_EQ(q.back().num(), 99);
+
+  // growing straightens the ring out
+  q.push_back(TestObj{100});
+  q.push_back(TestObj{101});
+  EXPECT_EQ(q.capacity(), 8);
+  expectNums(q, {97, 98, 99, 100, 101});
+}
+
+TEST(QueueTest, MatchesStdDeque) {
+  Queue<int> q{};
+  std::deque<int> expected{};
+  for (int i{}; i < 10000; ++i) {
+    if (!expected.empty() && Random::uniformRand(0, 2) == 0) {
+      EXPECT_EQ(q.pop_front(), expected.front());
+      expected.pop_front();
+    } else {
+      q.push_back(i);
+      expected.push_back(i);
+    }
+  }
+  ASSERT_EQ(q.size(), expected.size());
+  EXPECT_TRUE(std::equal(q.begin(), q.end(), expected.begin()));
+}
+
+TEST(QueueTest, Batches) {
+  Queue<int> q(8);
+  int values[]{0, 1, 2, 3, 4, 5};
+  q.push_back_n(values, 6);
+  int out[6]{};
+  EXPECT_EQ(q.pop_front_n(out, 4), 4);
+  EXPECT_EQ(out[3], 3);
+
+  // wraps: 4, 5 at the end of the storage, 10..14 at the start
+  Vector<int> more{10, 11, 12, 13, 14};
+  q.push_back_n(more.begin(), more.size());
+  EXPECT_EQ(q.capacity(), 8);
+  EXPECT_EQ(q.size(), 7);
+
+  Vector<int> drained{};
+  EXPECT_EQ(q.pop_front_n(std::back_inserter(drained), 100), 7);
+  EXPECT_TRUE(q.empty());
+  ASSERT_EQ(drained.size(), 7);
+  EXPECT_EQ(drained[1], 5);
+  EXPECT_EQ(drained[2], 10);
+  EXPECT_EQ(drained[6], 14);
+
+  // growing in the middle of a batch
+  int many[20]{};
+  q.push_back_n(many, 20);
+  EXPECT_EQ(q.size(), 20);
+}
+
+TEST(QueueTest, InsertEraseAcrossTheWrap) {
+  Queue<TestObj> q(6);
+  for (int i{}; i < 4; ++i) {
+    q.push_back(TestObj{i});
+  }
+  q.pop_front();
+  q.pop_front();
+  for (int i{4}; i < 7; ++i) {
+    q.push_back(TestObj{i});
+  }
+  expectNums(q, {2, 3, 4, 5, 6});
+
+  auto pos{q.insert(q.begin() + 1, TestObj{9})};
+  EXPECT_EQ(pos->num(), 9);
+  expectNums(q, {2, 9, 3, 4, 5, 6});
+
+  TestObj values[]{TestObj{7}, TestObj{8}};
+  q.insert(q.end(), values, values + 2);
+  expectNums(q, {2, 9, 3, 4, 5, 6, 7, 8});
+
+  q.erase(q.begin() + 1);
+  q.erase(q.begin() + 4, q.end());
+  expectNums(q, {2, 3, 4, 5});
+
+  Queue<TestObj> copy{q};
+  q.pop_front();
+  expectNums(copy, {2, 3, 4, 5});
+  Queue<TestObj> moved{std::move(q)};
+  expectNums(moved, {3, 4, 5});
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(PerfTest, QueueFifo) {
+  constexpr int depth{1000};
+  constexpr int rounds{10000000};
+  long long sum{};
+
+  std::queue<int> stdQueue{};
+  for (int i{}; i < depth; ++i) {
+    stdQueue.push(i);
+  }
+  Timer timer{};
+  for (int i{}; i < rounds; ++i) {
+    stdQueue.push(i);
+    sum += stdQueue.front();
+    stdQueue.pop();
+  }
+  std::cout << "STD QUEUE: " << timer.elapsed() << "\n";
+
+  Queue<int> queue{};
+  for (int i{}; i < depth; ++i) {
+    queue.push_back(i);
+  }
+  timer.reset();
+  for (int i{}; i < rounds; ++i) {
+    queue.push_back(i);
+    sum -= queue.pop_front();
+  }
+  std::cout << "QUEUE: " << timer.elapsed() << "\n";
+
+  int batch[64]{};
+  timer.reset();
+  for (int i{}; i < rounds; i += 64) {
+    queue.push_back_n(batch, 64);
+    queue.pop_front_n(batch, 64);
+  }
+  std::cout << "QUEUE BATCHES OF 64: " << timer.elapsed() << "\n";
+  EXPECT_EQ(sum, 0);
+}
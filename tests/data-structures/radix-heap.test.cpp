@@ -0,0 +1,195 @@
+#include <cstddef>
+#include <cstdint>
+#include <fibonacci-heap.hpp>
+#include <gtest/gtest.h>
+#include <heap.hpp>
+#include <iostream>
+#include <limits>
+#include <radix-heap.hpp>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <timer.hpp>
+#include <utility>
+#include <vector.hpp>
+
+TEST(RadixHeapTest, PopsInOrder) {
+  RadixHeap<std::uint32_t, int> heap{};
+  EXPECT_TRUE(heap.empty());
+  heap.push(5, 0);
+  heap.push(1, 1);
+  heap.push(1000, 2);
+  heap.push(5, 3);
+  EXPECT_EQ(heap.size(), 4);
+  EXPECT_EQ(heap.top().first, 1);
+  EXPECT_EQ(heap.pop().second, 1);
+  EXPECT_EQ(heap.last_key(), 1);
+  EXPECT_EQ(heap.pop().first, 5);
+  // equal to the last key is fine, below it is not
+  heap.push(5, 4);
+  EXPECT_THROW(heap.push(4, 5), std::invalid_argument);
+  EXPECT_EQ(heap.pop().first, 5);
+  EXPECT_EQ(heap.pop().first, 5);
+  EXPECT_EQ(heap.pop().first, 1000);
+  EXPECT_TRUE(heap.empty());
+}
+
+// pops and pushes at or above the last key, against a multiset
+TEST(RadixHeapTest, MatchesMultiset) {
+  std::mt19937_64 rng{5};
+  std::uniform_int_distribution<std::uint64_t> step{0, 1 << 20};
+  std::uniform_int_distribution<int> coin{0, 2};
+  RadixHeap<std::uint64_t, std::uint64_t> heap{};
+  std::multiset<std::uint64_t> expected{};
+  std::uint64_t last{};
+  for (int i{}; i < 50000; ++i) {
+    if (expected.empty() || coin(rng) != 0) {
+      std::uint64_t key{last + step(rng)};
+      heap.push(key, key);
+      expected.insert(key);
+    } else {
+      auto [key, value] = heap.pop();
+      EXPECT_EQ(key, value);
+      ASSERT_EQ(key, *expected.begin());
+      expected.erase(expected.begin());
+      last = key;
+    }
+  }
+  // keys at the top of the range land in the highest bucket
+  heap.push(std::numeric_limits<std::uint64_t>::max(), 0);
+  expected.insert(std::numeric_limits<std::uint64_t>::max());
+  for (std::uint64_t key : expected) {
+    ASSERT_EQ(heap.pop().first, key);
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+// width x height grid, edges to the 4 neighbours with random weights
+struct Grid {
+  std::size_t width{};
+  std::size_t height{};
+  // weight of the edge into vertex v, the same from every neighbour
+  Vector<std::uint32_t> weights{};
+
+  std::size_t size() const { return width * height; }
+
+  template <typename Fn> void neighbours(std::size_t v, Fn fn) const {
+    std::size_t x{v % width};
+    std::size_t y{v / width};
+    if (x > 0) {
+      fn(v - 1);
+    }
+    if (x + 1 < width) {
+      fn(v + 1);
+    }
+    if (y > 0) {
+      fn(v - width);
+    }
+    if (y + 1 < height) {
+      fn(v + width);
+    }
+  }
+};
+
+Grid randomGrid(std::size_t width, std::size_t height) {
+  std::mt19937 rng{17};
+  std::uniform_int_distribution<std::uint32_t> weight{1, 100};
+  Grid grid{width, height, Vector<std::uint32_t>(width * height)};
+  for (std::size_t v{}; v < grid.size(); ++v) {
+    grid.weights.push_back(weight(rng));
+  }
+  return grid;
+}
+
+constexpr std::uint64_t UNREACHED{std::numeric_limits<std::uint64_t>::max()};
+
+Vector<std::uint64_t> unreached(std::size_t size) {
+  Vector<std::uint64_t> distance(size);
+  for (std::size_t v{}; v < size; ++v) {
+    distance.push_back(UNREACHED);
+  }
+  return distance;
+}
+
+// queues without decrease-key take an entry per relaxation and skip stale
+// ones when they come out
+template <typename PushFn, typename PopFn, typename EmptyFn>
+Vector<std::uint64_t> dijkstraLazy(const Grid& grid, PushFn push, PopFn pop,
+                                   EmptyFn empty) {
+  Vector<std::uint64_t> distance{unreached(grid.size())};
+  distance[0] = 0;
+  push(0, 0);
+  while (!empty()) {
+    auto [d, v] = pop();
+    if (d > distance[v]) {
+      continue;
+    }
+    grid.neighbours(v, [&](std::size_t to) {
+      std::uint64_t candidate{d + grid.weights[to]};
+      if (candidate < distance[to]) {
+        distance[to] = candidate;
+        push(candidate, to);
+      }
+    });
+  }
+  return distance;
+}
+
+Vector<std::uint64_t> dijkstraFibonacci(const Grid& grid) {
+  using Heap = FibonacciHeap<std::uint64_t, std::size_t>;
+  Vector<std::uint64_t> distance{unreached(grid.size())};
+  Vector<Heap::Handle> handles(grid.size());
+  for (std::size_t v{}; v < grid.size(); ++v) {
+    handles.push_back(Heap::Handle{});
+  }
+  Heap heap{};
+  distance[0] = 0;
+  heap.insert(std::uint64_t{0}, std::size_t{0});
+  while (!heap.empty()) {
+    auto [d, v] = heap.extract_top();
+    grid.neighbours(v, [&](std::size_t to) {
+      std::uint64_t candidate{d + grid.weights[to]};
+      if (candidate >= distance[to]) {
+        return;
+      }
+      if (distance[to] == UNREACHED) {
+        handles[to] = heap.insert(candidate, to);
+      } else {
+        heap.decrease_key(handles[to], candidate);
+      }
+      distance[to] = candidate;
+    });
+  }
+  return distance;
+}
+
+TEST(PerfTest, GridDijkstra) {
+  Grid grid{randomGrid(1000, 1000)};
+
+  Timer timer{};
+  MinHeap<std::pair<std::uint64_t, std::size_t>> binary{};
+  Vector<std::uint64_t> binaryDistance{dijkstraLazy(
+      grid,
+      [&](std::uint64_t key, std::size_t v) { binary.push({key, v}); },
+      [&]() { return binary.pop(); }, [&]() { return binary.empty(); })};
+  double binaryTime{timer.elapsed()};
+
+  timer.reset();
+  RadixHeap<std::uint64_t, std::size_t> radix{};
+  Vector<std::uint64_t> radixDistance{dijkstraLazy(
+      grid, [&](std::uint64_t key, std::size_t v) { radix.push(key, v); },
+      [&]() { return radix.pop(); }, [&]() { return radix.empty(); })};
+  double radixTime{timer.elapsed()};
+
+  timer.reset();
+  Vector<std::uint64_t> fibonacciDistance{dijkstraFibonacci(grid)};
+  double fibonacciTime{timer.elapsed()};
+
+  for (std::size_t v{}; v < grid.size(); ++v) {
+    ASSERT_EQ(binaryDistance[v], radixDistance[v]);
+    ASSERT_EQ(binaryDistance[v], fibonacciDistance[v]);
+  }
+  std::cout << "DIJKSTRA 1000x1000 GRID: HEAP " << binaryTime
+            << " s, RADIX HEAP " << radixTime << " s, FIBONACCI HEAP "
+            << fibonacciTime << " s\n";
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <helpers.hpp>
+#include <small-vector.hpp>
+#include <string>
+#include <timer.hpp>
+#include <tracking-allocator.hpp>
+#include <vector.hpp>
+
+using TestObj = helpers::Test;
+using OutOfRange = SmallVector<TestObj, 3>::OutOfRangeException;
+
+struct SmallVectorPool {
+  static constexpr const char name[]{"SmallVector"};
+};
+
+template <typename V>
+void expectNums(const V& v, std::initializer_list<int> l) {
+  ASSERT_EQ(v.size(), l.size());
+  std::size_t index{};
+  for (int num : l) {
+    EXPECT_EQ(v[index++].num(), num);
+  }
+}
+
+TEST(SmallVectorTest, StaysInlineUpToN) {
+  using Alloc = TrackingAllocator<TestObj, SmallVectorPool>;
+  SmallVector<TestObj, 4, Alloc> v{};
+  for (int i{}; i < 4; ++i) {
+    v.push_back(TestObj{i});
+  }
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(Alloc::stats().allocations, 0);
+
+  v.emplace_back(4);
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_EQ(Alloc::stats().allocations, 1);
+  expectNums(v, {0, 1, 2, 3, 4});
+
+  v.pop_back();
+  v.shrink_to_fit();
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(Alloc::stats().liveBytes, 0);
+  expectNums(v, {0, 1, 2, 3});
+}
+
+TEST(SmallVectorTest, InsertErase) {
+  SmallVector<TestObj, 3> v{TestObj{1}, TestObj{3}};
+  v.insert(1, TestObj{2});
+  v.insert(0, TestObj{0});
+  v.insert(v.size(), TestObj{4});
+  expectNums(v, {0, 1, 2, 3, 4});
+
+  TestObj values[]{TestObj{7}, TestObj{8}};
+  v.insert(2, values, values + 2);
+  expectNums(v, {0, 1, 7, 8, 2, 3, 4});
+
+  v.erase(2, 3);
+  expectNums(v, {0, 1, 2, 3, 4});
+  v.erase(v.begin());
+  v.erase(3);
+  expectNums(v, {1, 2, 3});
+
+  v.reverse();
+  expectNums(v, {3, 2, 1});
+  EXPECT_THROW(v.at(3), OutOfRange);
+  EXPECT_THROW(v.insert(5, TestObj{5}), OutOfRange);
+}
+
+TEST(SmallVectorTest, CopyMoveSwap) {
+  SmallVector<std::string, 2> inlineV{"a", "b"};
+  SmallVector<std::string, 2> heapV{"c", "d", "e"};
+
+  SmallVector<std::string, 2> copy{heapV};
+  EXPECT_EQ(copy.size(), 3);
+  EXPECT_EQ(copy[2], "e");
+
+  SmallVector<std::string, 2> moved{std::move(inlineV)};
+  EXPECT_TRUE(inlineV.empty());
+  EXPECT_TRUE(moved.is_inline());
+  EXPECT_EQ(moved[1], "b");
+
+  const std::string* heapData{heapV.data()};
+  SmallVector<std::string, 2> stolen{std::move(heapV)};
+  EXPECT_EQ(stolen.data(), heapData);
+  EXPECT_TRUE(heapV.is_inline());
+
+  swap(moved, stolen);
+  EXPECT_EQ(moved.size(), 3);
+  EXPECT_EQ(stolen.size(), 2);
+  EXPECT_EQ(stolen[0], "a");
+  EXPECT_EQ(moved[0], "c");
+
+  copy = moved;
+  moved = std::move(stolen);
+  EXPECT_EQ(copy[1], "d");
+  EXPECT_EQ(moved[1], "b");
+}
+
+TEST(SmallVectorTest, SelfAliasingPush) {
+  SmallVector<std::string, 2> v{"x", "y"};
+  v.push_back(v[0]);
+  v.emplace_back(v[1]);
+  EXPECT_EQ(v[2], "x");
+  EXPECT_EQ(v[3], "y");
+}
+
+// the element is read before the gap is opened, inline and after growing
+TEST(SmallVectorTest, SelfAliasingInsert) {
+  SmallVector<std::string, 4> inlined{"a", "b", "c"};
+  inlined.insert(0, inlined[1]);
+  EXPECT_EQ(inlined.size(), 4);
+  EXPECT_EQ(inlined[0], "b");
+  EXPECT_EQ(inlined[1], "a");
+  EXPECT_EQ(inlined[2], "b");
+  EXPECT_EQ(inlined[3], "c");
+
+  SmallVector<std::string, 4> grown{"a", "b", "c", "d"};
+  grown.insert(0, grown[1]);
+  EXPECT_EQ(grown.size(), 5);
+  EXPECT_EQ(grown[0], "b");
+  EXPECT_EQ(grown[1], "a");
+  EXPECT_EQ(grown[2], "b");
+  EXPECT_EQ(grown[3], "c");
+  EXPECT_EQ(grown[4], "d");
+
+  grown.insert(1, grown[4], grown[0]);
+  EXPECT_EQ(grown[1], "d");
+  EXPECT_EQ(grown[2], "b");
+  EXPECT_EQ(grown[3], "a");
+}
+
+TEST(PerfTest, ShortLists) {
+  Timer timer{};
+  for (int i{}; i < 200000; ++i) {
+    Vector<int> v{};
+    for (int j{}; j < 6; ++j) {
+      v.push_back(j);
+    }
+  }
+  std::cout << "VECTOR: " << timer.elapsed() << "\n";
+
+  timer.reset();
+  for (int i{}; i < 200000; ++i) {
+    SmallVector<int, 8> v{};
+    for (int j{}; j < 6; ++j) {
+      v.push_back(j);
+    }
+  }
+  std::cout << "SMALL VECTOR: " << timer.elapsed() << "\n";
+}
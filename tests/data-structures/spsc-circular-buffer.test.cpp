@@ -0,0 +1,218 @@
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <pthread.h>
+#include <spsc-circular-buffer.hpp>
+#include <static-circular-buffer.hpp>
+#include <thread>
+#include <timer.hpp>
+#include <vector.hpp>
+
+TEST(SpscCircularBufferTest, PushPopWrapAround) {
+  // 5 is stored in 8 slots, but only 5 may be taken
+  SpscCircularBuffer<int, 5> buffer{};
+  EXPECT_EQ(buffer.capacity(), 5);
+  EXPECT_FALSE(buffer.try_pop_front().has_value());
+  for (int i{}; i < 5; ++i) {
+    EXPECT_TRUE(buffer.try_push_back(i));
+  }
+  EXPECT_TRUE(buffer.is_full());
+  EXPECT_FALSE(buffer.try_push_back(5));
+
+  for (int i{5}; i < 100; ++i) {
+    EXPECT_EQ(buffer.pop_front(), i - 5);
+    buffer.push_back(i);
+  }
+  EXPECT_EQ(buffer.size(), 5);
+  for (int i{95}; i < 100; ++i) {
+    EXPECT_EQ(buffer.try_pop_front(), i);
+  }
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SpscCircularBufferTest, Batches) {
+  SpscCircularBuffer<int, 8> buffer{};
+  int values[]{0, 1, 2, 3, 4, 5};
+  EXPECT_EQ(buffer.try_push_n(values, 6), 6);
+  int out[8]{};
+  EXPECT_EQ(buffer.try_pop_n(out, 4), 4);
+  EXPECT_EQ(out[3], 3);
+
+  // only 6 of these fit, the last ones wrap to the start of the storage
+  Vector<int> more{10, 11, 12, 13, 14, 15, 16, 17};
+  EXPECT_EQ(buffer.try_push_n(more.begin(), more.size()), 6);
+  EXPECT_TRUE(buffer.is_full());
+
+  Vector<int> drained{};
+  EXPECT_EQ(buffer.try_pop_n(std::back_inserter(drained), 100), 8);
+  ASSERT_EQ(drained.size(), 8);
+  EXPECT_EQ(drained[0], 4);
+  EXPECT_EQ(drained[1], 5);
+  EXPECT_EQ(drained[2], 10);
+  EXPECT_EQ(drained[7], 15);
+  EXPECT_EQ(buffer.try_pop_n(out, 1), 0);
+}
+
+// pins the calling thread to a core, so the two sides of a benchmark don't
+// share or hop between cores. Wraps around on smaller machines.
+void pinToCore(std::size_t core) {
+  std::size_t cores{std::max(1u, std::thread::hardware_concurrency())};
+  cpu_set_t set{};
+  CPU_ZERO(&set);
+  CPU_SET(core % cores, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+TEST(SpscCircularBufferTest, ProducerConsumerKeepOrder) {
+  constexpr int items{1'000'000};
+  SpscCircularBuffer<int, 100> buffer{};
+  std::thread producer{[&]() {
+    for (int i{}; i < items;) {
+      if (i % 7 == 0) {
+        int batch[]{i, i + 1, i + 2};
+        std::size_t count{std::min<std::size_t>(
+            3, static_cast<std::size_t>(items - i))};
+        i += static_cast<int>(buffer.try_push_n(batch, count));
+      } else {
+        buffer.push_back(i++);
+      }
+    }
+  }};
+
+  int expected{};
+  int out[16]{};
+  while (expected < items) {
+    std::size_t count{buffer.try_pop_n(out, 16)};
+    for (std::size_t i{}; i < count; ++i) {
+      ASSERT_EQ(out[i], expected++);
+    }
+    if (count == 0) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(buffer.empty());
+}
+
+// StaticCircularBuffer behind a mutex, what the SPSC buffer replaces
+template <typename T, std::size_t N> struct LockedBuffer {
+  std::mutex _mutex{};
+  StaticCircularBuffer<T, N> _buffer{};
+
+  bool try_push_back(T value) {
+    std::lock_guard lock{_mutex};
+    if (_buffer.is_full()) {
+      return false;
+    }
+    _buffer.push_back(value);
+    return true;
+  }
+
+  std::optional<T> try_pop_front() {
+    std::lock_guard lock{_mutex};
+    if (_buffer.empty()) {
+      return std::nullopt;
+    }
+    return _buffer.pop_front();
+  }
+};
+
+template <typename Buffer> double throughput(Buffer& buffer, int items) {
+  long long sum{};
+  Timer timer{};
+  std::thread producer{[&]() {
+    pinToCore(1);
+    for (int i{}; i < items; ++i) {
+      while (!buffer.try_push_back(i)) {
+        std::this_thread::yield();
+      }
+    }
+  }};
+  pinToCore(0);
+  for (int i{}; i < items; ++i) {
+    std::optional<int> value{buffer.try_pop_front()};
+    while (!value) {
+      std::this_thread::yield();
+      value = buffer.try_pop_front();
+    }
+    sum += *value;
+  }
+  producer.join();
+  double elapsed{timer.elapsed()};
+  EXPECT_EQ(sum, static_cast<long long>(items) * (items - 1) / 2);
+  return items / elapsed;
+}
+
+TEST(PerfTest, SpscThroughput) {
+  constexpr int items{5'000'000};
+  LockedBuffer<int, 1024> locked{};
+  double lockedRate{throughput(locked, items)};
+  std::cout << "MUTEX STATIC CIRCULAR BUFFER: " << lockedRate << " items/s\n";
+
+  SpscCircularBuffer<int, 1024> spsc{};
+  double spscRate{throughput(spsc, items)};
+  std::cout << "SPSC CIRCULAR BUFFER: " << spscRate << " items/s\n";
+
+  constexpr std::size_t batch{64};
+  SpscCircularBuffer<int, 1024> batched{};
+  long long sum{};
+  Timer timer{};
+  std::thread producer{[&]() {
+    pinToCore(1);
+    int values[batch]{};
+    for (int i{}; i < items;) {
+      std::size_t count{std::min(batch, static_cast<std::size_t>(items - i))};
+      for (std::size_t j{}; j < count; ++j) {
+        values[j] = i + static_cast<int>(j);
+      }
+      std::size_t pushed{batched.try_push_n(values, count)};
+      if (pushed == 0) {
+        std::this_thread::yield();
+      }
+      // whatever did not fit is rebuilt on the next round
+      i += static_cast<int>(pushed);
+    }
+  }};
+  pinToCore(0);
+  int values[batch]{};
+  for (int received{}; received < items;) {
+    std::size_t count{batched.try_pop_n(values, batch)};
+    if (count == 0) {
+      std::this_thread::yield();
+    }
+    for (std::size_t j{}; j < count; ++j) {
+      sum += values[j];
+    }
+    received += static_cast<int>(count);
+  }
+  producer.join();
+  double elapsed{timer.elapsed()};
+  std::cout << "SPSC CIRCULAR BUFFER BATCHES OF " << batch << ": "
+            << items / elapsed << " items/s\n";
+  EXPECT_EQ(sum, static_cast<long long>(items) * (items - 1) / 2);
+}
+
+// ping-pong over two buffers: each message crosses between the cores twice
+TEST(PerfTest, SpscLatency) {
+  constexpr int rounds{200'000};
+  SpscCircularBuffer<int, 16> ping{};
+  SpscCircularBuffer<int, 16> pong{};
+  std::thread echo{[&]() {
+    pinToCore(1);
+    for (int i{}; i < rounds; ++i) {
+      pong.push_back(ping.pop_front());
+    }
+  }};
+  pinToCore(0);
+  Timer timer{};
+  for (int i{}; i < rounds; ++i) {
+    ping.push_back(i);
+    EXPECT_EQ(pong.pop_front(), i);
+  }
+  double elapsed{timer.elapsed()};
+  echo.join();
+  std::cout << "SPSC ROUND TRIP: " << elapsed / rounds * 1e9 << " ns\n";
+}
@@ -0,0 +1,186 @@
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <helpers.hpp>
+#include <iostream>
+#include <iterator>
+#include <list.hpp>
+#include <list>
+#include <random.hpp>
+#include <timer.hpp>
+#include <unrolled-list.hpp>
+#include <utility>
+
+using TestObj = helpers::Test;
+// small blocks so a handful of elements already splits and merges
+using SmallBlocks = UnrolledList<TestObj, 4>;
+
+template <typename L>
+void expectNums(const L& l, std::initializer_list<int> nums) {
+  ASSERT_EQ(l.size(), nums.size());
+  auto iter{l.begin()};
+  for (int num : nums) {
+    EXPECT_EQ((iter++)->num(), num);
+  }
+  EXPECT_EQ(iter, l.end());
+}
+
+TEST(UnrolledListTest, PushPop) {
+  SmallBlocks l{};
+  for (int i{}; i < 10; ++i) {
+    l.push_back(TestObj{i});
+  }
+  l.push_front(TestObj{-1});
+  l.emplace_front(-2);
+  expectNums(l, {-2, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+  EXPECT_EQ(l.front().num(), -2);
+  EXPECT_EQ(l.back().num(), 9);
+
+  l.pop_front();
+  l.pop_back();
+  expectNums(l, {-1, 0, 1, 2, 3, 4, 5, 6, 7, 8});
+  for (std::size_t i{}; i < l.size(); ++i) {
+    EXPECT_EQ(l[i].num(), static_cast<int>(i) - 1);
+  }
+  EXPECT_THROW(l.at(l.size()), SmallBlocks::OutOfRangeException);
+
+  while (!l.empty()) {
+    l.pop_back();
+  }
+  EXPECT_EQ(l.begin(), l.end());
+}
+
+TEST(UnrolledListTest, InsertErase) {
+  SmallBlocks l{TestObj{0}, TestObj{1}, TestObj{2}, TestObj{3}};
+  auto pos{l.insert(std::next(l.begin(), 2), TestObj{9})};
+  EXPECT_EQ(pos->num(), 9);
+  expectNums(l, {0, 1, 9, 2, 3});
+
+  TestObj values[]{TestObj{7}, TestObj{8}, TestObj{6}, TestObj{5}};
+  pos = l.insert(std::next(l.begin()), values, values + 4);
+  EXPECT_EQ(pos->num(), 7);
+  expectNums(l, {0, 7, 8, 6, 5, 1, 9, 2, 3});
+
+  pos = l.erase(std::next(l.begin()), std::next(l.begin(), 5));
+  EXPECT_EQ(pos->num(), 1);
+  expectNums(l, {0, 1, 9, 2, 3});
+  pos = l.erase(std::prev(l.end()));
+  EXPECT_EQ(pos, l.end());
+  expectNums(l, {0, 1, 9, 2});
+}
+
+TEST(UnrolledListTest, MatchesStdList) {
+  // random inserts and erases in the middle, checked against std::list
+  UnrolledList<int, 8> l{};
+  std::list<int> expected{};
+  for (int i{}; i < 5000; ++i) {
+    int index{Random::uniformRand(0, static_cast<int>(expected.size()))};
+    if (expected.size() > 0 && Random::uniformRand(0, 2) == 0 &&
+        index < static_cast<int>(expected.size())) {
+      auto got{l.erase(std::next(l.begin(), index))};
+      auto want{expected.erase(std::next(expected.begin(), index))};
+      EXPECT_EQ(std::distance(l.begin(), got),
+                std::distance(expected.begin(), want));
+    } else {
+      auto got{l.insert(std::next(l.begin(), index), i)};
+      expected.insert(std::next(expected.begin(), index), i);
+      EXPECT_EQ(*got, i);
+    }
+  }
+  ASSERT_EQ(l.size(), expected.size());
+  EXPECT_TRUE(std::equal(l.begin(), l.end(), expected.begin()));
+  EXPECT_TRUE(std::equal(l.rbegin(), l.rend(), expected.rbegin()));
+  std::size_t index{};
+  for (int num : expected) {
+    EXPECT_EQ(l[index++], num);
+  }
+}
+
+TEST(UnrolledListTest, Splice) {
+  SmallBlocks l1{TestObj{0}, TestObj{1}, TestObj{2}, TestObj{3},
+                 TestObj{4}};
+  SmallBlocks l2{TestObj{10}, TestObj{11}, TestObj{12}, TestObj{13},
+                 TestObj{14}};
+  l1.splice(std::next(l1.begin(), 2), l2);
+  EXPECT_TRUE(l2.empty());
+  expectNums(l1, {0, 1, 10, 11, 12, 13, 14, 2, 3, 4});
+
+  l1.splice(l1.end(), SmallBlocks{TestObj{20}});
+  l1.splice(l1.begin(), SmallBlocks{TestObj{-1}});
+  expectNums(l1, {-1, 0, 1, 10, 11, 12, 13, 14, 2, 3, 4, 20});
+  EXPECT_EQ(l1[11].num(), 20);
+}
+
+TEST(UnrolledListTest, CopyMoveSwap) {
+  SmallBlocks l1{TestObj{1}, TestObj{2}, TestObj{3}, TestObj{4},
+                 TestObj{5}};
+  SmallBlocks copy{l1};
+  expectNums(copy, {1, 2, 3, 4, 5});
+
+  SmallBlocks moved{std::move(l1)};
+  EXPECT_TRUE(l1.empty());
+  expectNums(moved, {1, 2, 3, 4, 5});
+
+  SmallBlocks empty{};
+  swap(moved, empty);
+  EXPECT_TRUE(moved.empty());
+  expectNums(empty, {1, 2, 3, 4, 5});
+
+  moved = empty;
+  copy = std::move(empty);
+  expectNums(moved, {1, 2, 3, 4, 5});
+  expectNums(copy, {1, 2, 3, 4, 5});
+  copy.push_back(TestObj{6});
+  EXPECT_EQ(copy.back().num(), 6);
+}
+
+TEST(PerfTest, Traversal) {
+  constexpr int count{1'000'000};
+  List<int> list{};
+  UnrolledList<int> unrolled{};
+  for (int i{}; i < count; ++i) {
+    list.push_back(i);
+    unrolled.push_back(i);
+  }
+
+  long long sum{};
+  Timer timer{};
+  for (int round{}; round < 10; ++round) {
+    for (int num : list) {
+      sum += num;
+    }
+  }
+  std::cout << "LIST TRAVERSAL: " << timer.elapsed() << "\n";
+
+  timer.reset();
+  for (int round{}; round < 10; ++round) {
+    for (int num : unrolled) {
+      sum -= num;
+    }
+  }
+  std::cout << "UNROLLED LIST TRAVERSAL: " << timer.elapsed() << "\n";
+  EXPECT_EQ(sum, 0);
+}
+
+TEST(PerfTest, IndexedAccess) {
+  constexpr int count{100'000};
+  List<int> list{};
+  UnrolledList<int> unrolled{};
+  for (int i{}; i < count; ++i) {
+    list.push_back(i);
+    unrolled.push_back(i);
+  }
+
+  long long sum{};
+  Timer timer{};
+  for (std::size_t i{}; i < count; i += 97) {
+    sum += list[i];
+  }
+  std::cout << "LIST INDEXED: " << timer.elapsed() << "\n";
+
+  timer.reset();
+  for (std::size_t i{}; i < count; i += 97) {
+    sum -= unrolled[i];
+  }
+  std::cout << "UNROLLED LIST INDEXED: " << timer.elapsed() << "\n";
+  EXPECT_EQ(sum, 0);
+}
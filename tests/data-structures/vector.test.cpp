@@ -1,6 +1,12 @@
+#include <caching-allocator.hpp>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <helpers.hpp>
+#include <iterator>
+#include <sstream>
+#include <string>
 #include <timer.hpp>
+#include <utility>
 #include <vector.hpp>
 #include <vector>
 
@@ -18,4 +24,221 @@ TEST(PerfTest, StdVector) {
   for (int i{}; i < 100000; ++i) {
     v.push_back(helpers::Test{i});
   }
-}
\ No newline at end of file
+}
+
+// same layout as int, but its user-provided move constructor keeps Vector on
+// the element-by-element path
+struct SlowInt {
+  int value{};
+  SlowInt(int v = 0) : value{v} {}
+  SlowInt(const SlowInt& other) : value{other.value} {}
+  SlowInt(SlowInt&& other) noexcept : value{other.value} {}
+  SlowInt& operator=(const SlowInt& other) = default;
+  bool operator==(const SlowInt& other) const = default;
+};
+
+template <typename T> class VectorRelocationTest : public ::testing::Test {};
+
+using RelocationTypes = ::testing::Types<int, std::pair<int, int>, SlowInt,
+                                         helpers::Test>;
+TYPED_TEST_SUITE(VectorRelocationTest, RelocationTypes);
+
+template <typename T> T makeValue(int i) {
+  if constexpr (std::is_same_v<T, std::pair<int, int>>) {
+    return T{i, -i};
+  } else {
+    return T{i};
+  }
+}
+
+template <typename T> int valueOf(const T& value) {
+  if constexpr (std::is_same_v<T, std::pair<int, int>>) {
+    return value.first;
+  } else if constexpr (std::is_same_v<T, SlowInt>) {
+    return value.value;
+  } else if constexpr (std::is_same_v<T, helpers::Test>) {
+    return value.num();
+  } else {
+    return value;
+  }
+}
+
+TYPED_TEST(VectorRelocationTest, GrowInsertErase) {
+  using T = TypeParam;
+  Vector<T> v(1);
+  for (int i{}; i < 100; ++i) {
+    v.push_back(makeValue<T>(i));
+  }
+  v.insert(0, makeValue<T>(-1));
+  v.insert(50, makeValue<T>(-2));
+  T values[]{makeValue<T>(-3), makeValue<T>(-4)};
+  v.insert(10, values[0], values[1]);
+  ASSERT_EQ(v.size(), 104);
+  EXPECT_EQ(valueOf(v[0]), -1);
+  EXPECT_EQ(valueOf(v[1]), 0);
+  EXPECT_EQ(valueOf(v[10]), -3);
+  EXPECT_EQ(valueOf(v[11]), -4);
+  EXPECT_EQ(valueOf(v[12]), 9);
+  EXPECT_EQ(valueOf(v[52]), -2);
+  EXPECT_EQ(valueOf(v[103]), 99);
+
+  v.erase(52);
+  v.erase(10, 11);
+  v.erase(v.begin());
+  ASSERT_EQ(v.size(), 100);
+  for (int i{}; i < 100; ++i) {
+    EXPECT_EQ(valueOf(v[static_cast<std::size_t>(i)]), i);
+  }
+}
+
+template <typename T> void benchmarkRelocation(const char* name) {
+  for (std::size_t count : {std::size_t{1'000'000}, std::size_t{10'000'000}}) {
+    Timer timer{};
+    Vector<T> v{};
+    for (std::size_t i{}; i < count; ++i) {
+      v.push_back(makeValue<T>(static_cast<int>(i)));
+    }
+    double growTime{timer.elapsed()};
+
+    timer.reset();
+    for (int i{}; i < 10; ++i) {
+      v.insert(static_cast<std::size_t>(i), makeValue<T>(i));
+    }
+    double insertTime{timer.elapsed()};
+
+    timer.reset();
+    for (std::size_t i{}; i < 10; ++i) {
+      v.erase(i, i + 9);
+    }
+    double eraseTime{timer.elapsed()};
+
+    std::cout << name << " " << count << ": grow " << growTime
+              << " front insert x10 " << insertTime << " range erase x10 "
+              << eraseTime << "\n";
+  }
+}
+
+TEST(PerfTest, Relocation) {
+  benchmarkRelocation<int>("INT");
+  benchmarkRelocation<std::pair<int, int>>("PAIR");
+  benchmarkRelocation<SlowInt>("INT (ELEMENT LOOP)");
+}
+
+// the default allocator is stateless and adds nothing to the size
+static_assert(sizeof(Vector<int>) == 2 * sizeof(std::size_t) + sizeof(int*));
+
+static_assert(GrowHalf::next_capacity<Allocator<int>>(10, 11) == 15);
+static_assert(GrowDouble::next_capacity<Allocator<int>>(10, 11) == 20);
+static_assert(GrowDouble::next_capacity<Allocator<int>>(10, 100) == 100);
+static_assert(GrowDouble::next_capacity<Allocator<int>>(0, 1) == 2);
+// 25 ints = 100 bytes sit in the 112 byte size class, room for 28
+static_assert(AllocatorSizedGrowth<GrowHalf>::next_capacity<
+                  CachingAllocator<int>>(17, 18) == 28);
+static_assert(AllocatorSizedGrowth<GrowHalf>::next_capacity<Allocator<int>>(
+                  17, 18) == 26);
+
+// the sequence Vector always had, std::round(capacity * 1.5) from 2
+TEST(VectorTest, GrowHalfCapacities) {
+  Vector<int> v{};
+  Vector<std::size_t> capacities{};
+  for (int i{}; i < 100; ++i) {
+    v.push_back(i);
+    if (capacities.empty() || capacities.back() != v.capacity()) {
+      capacities.push_back(v.capacity());
+    }
+  }
+  std::size_t expected[]{2, 3, 5, 8, 12, 18, 27, 41, 62, 93, 140};
+  ASSERT_EQ(capacities.size(), std::size(expected));
+  for (std::size_t i{}; i < capacities.size(); ++i) {
+    EXPECT_EQ(capacities[i], expected[i]);
+  }
+}
+
+TEST(VectorTest, GrowthPolicy) {
+  Vector<int, Allocator<int>, GrowDouble> doubling(4);
+  for (int i{}; i < 5; ++i) {
+    doubling.push_back(i);
+  }
+  EXPECT_EQ(doubling.capacity(), 8);
+
+  Vector<int, CachingAllocator<int>, AllocatorSizedGrowth<>> sized(17);
+  for (int i{}; i < 18; ++i) {
+    sized.push_back(i);
+  }
+  EXPECT_EQ(sized.capacity(), 28);
+  EXPECT_EQ(sized[16], 16);
+}
+
+TEST(VectorTest, Append) {
+  Vector<int> v{1, 2};
+  int values[]{3, 4, 5, 6, 7};
+  v.append(values, values + 5);
+  ASSERT_EQ(v.size(), 7);
+  EXPECT_EQ(v[6], 7);
+
+  // single pass input iterators fall back to push_back
+  std::istringstream stream{"8 9 10"};
+  v.append(std::istream_iterator<int>{stream}, std::istream_iterator<int>{});
+  ASSERT_EQ(v.size(), 10);
+  EXPECT_EQ(v[9], 10);
+
+  int* raw{v.append_uninitialized(3)};
+  EXPECT_EQ(v.size(), 13);
+  EXPECT_EQ(raw, v.data() + 10);
+  for (int i{}; i < 3; ++i) {
+    raw[i] = 11 + i;
+  }
+  for (std::size_t i{}; i < v.size(); ++i) {
+    EXPECT_EQ(v[i], static_cast<int>(i) + 1);
+  }
+
+  Vector<std::string> strings{};
+  std::string* added{strings.append_uninitialized(2)};
+  EXPECT_TRUE(added[0].empty());
+  added[1] = "appended";
+  EXPECT_EQ(strings[1], "appended");
+}
+
+template <typename Growth> void benchmarkIngestion(const char* name) {
+  constexpr std::size_t count{10'000'000};
+  constexpr std::size_t batch{4096};
+  int source[batch]{};
+  for (std::size_t i{}; i < batch; ++i) {
+    source[i] = static_cast<int>(i);
+  }
+
+  Timer timer{};
+  {
+    Vector<int, Allocator<int>, Growth> v{};
+    for (std::size_t i{}; i < count; ++i) {
+      v.push_back(source[i % batch]);
+    }
+  }
+  double pushTime{timer.elapsed()};
+
+  timer.reset();
+  {
+    Vector<int, Allocator<int>, Growth> v{};
+    for (std::size_t i{}; i < count; i += batch) {
+      v.append(source, source + batch);
+    }
+  }
+  double appendTime{timer.elapsed()};
+
+  timer.reset();
+  {
+    Vector<int, Allocator<int>, Growth> v{};
+    for (std::size_t i{}; i < count; i += batch) {
+      std::memcpy(v.append_uninitialized(batch), source, sizeof(source));
+    }
+  }
+  double uninitializedTime{timer.elapsed()};
+
+  std::cout << name << ": push_back " << pushTime << " append " << appendTime
+            << " append_uninitialized " << uninitializedTime << "\n";
+}
+
+TEST(PerfTest, Ingestion) {
+  benchmarkIngestion<GrowHalf>("1.5X");
+  benchmarkIngestion<GrowDouble>("2X");
+}
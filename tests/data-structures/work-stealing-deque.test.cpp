@@ -0,0 +1,135 @@
+#include <atomic>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <timer.hpp>
+#include <vector.hpp>
+#include <work-stealing-deque.hpp>
+
+TEST(WorkStealingDequeTest, OwnerLifoThiefFifo) {
+  WorkStealingDeque<int> deque{4};
+  EXPECT_EQ(deque.capacity(), 4);
+  for (int i{}; i < 100; ++i) {
+    deque.push(i);
+  }
+  EXPECT_EQ(deque.size(), 100);
+  EXPECT_GE(deque.capacity(), 100);
+
+  EXPECT_EQ(deque.pop(), 99);
+  EXPECT_EQ(deque.steal(), 0);
+  EXPECT_EQ(deque.steal(), 1);
+  EXPECT_EQ(deque.pop(), 98);
+
+  while (deque.pop()) {
+  }
+  EXPECT_TRUE(deque.empty());
+  EXPECT_FALSE(deque.pop().has_value());
+  EXPECT_FALSE(deque.steal().has_value());
+
+  deque.push(7);
+  EXPECT_EQ(deque.steal(), 7);
+  EXPECT_FALSE(deque.pop().has_value());
+}
+
+// the owner pushes (and sometimes pops) items while thieves steal them; every
+// item has to come out exactly once
+void stress(std::size_t thieves, int items) {
+  WorkStealingDeque<int> deque{2};
+  std::unique_ptr<std::atomic<int>[]> taken{
+      new std::atomic<int>[static_cast<std::size_t>(items)]{}};
+  std::atomic<bool> done{false};
+  std::atomic<int> count{0};
+
+  Vector<std::thread> threads(thieves);
+  for (std::size_t i{}; i < thieves; ++i) {
+    threads.push_back(std::thread{[&]() {
+      while (!done.load(std::memory_order_acquire)) {
+        if (std::optional<int> item{deque.steal()}) {
+          taken[static_cast<std::size_t>(*item)].fetch_add(1);
+          count.fetch_add(1);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }});
+  }
+
+  for (int i{}; i < items; ++i) {
+    deque.push(i);
+    if (i % 3 == 0) {
+      if (std::optional<int> item{deque.pop()}) {
+        taken[static_cast<std::size_t>(*item)].fetch_add(1);
+        count.fetch_add(1);
+      }
+    }
+  }
+  while (std::optional<int> item{deque.pop()}) {
+    taken[static_cast<std::size_t>(*item)].fetch_add(1);
+    count.fetch_add(1);
+  }
+  done.store(true, std::memory_order_release);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(count.load(), items);
+  for (int i{}; i < items; ++i) {
+    ASSERT_EQ(taken[static_cast<std::size_t>(i)].load(), 1) << "item " << i;
+  }
+}
+
+TEST(WorkStealingDequeTest, StressOneThief) { stress(1, 200000); }
+
+TEST(WorkStealingDequeTest, StressManyThieves) { stress(7, 200000); }
+
+// one owner keeps producing work; the owner and the thieves run it until
+// the total is done. Throughput is items per second over all threads.
+TEST(PerfTest, Throughput) {
+  constexpr int items{1'000'000};
+  constexpr std::size_t threadCounts[]{1, 2, 4, 8, 16, 32, 64};
+  for (std::size_t threadCount : threadCounts) {
+    WorkStealingDeque<int> deque{};
+    std::atomic<int> processed{0};
+    std::atomic<long long> sum{0};
+
+    auto work{[&](int item) {
+      sum.fetch_add(item, std::memory_order_relaxed);
+      processed.fetch_add(1, std::memory_order_relaxed);
+    }};
+
+    Timer timer{};
+    Vector<std::thread> thieves(threadCount);
+    for (std::size_t i{1}; i < threadCount; ++i) {
+      thieves.push_back(std::thread{[&]() {
+        while (processed.load(std::memory_order_relaxed) < items) {
+          if (std::optional<int> item{deque.steal()}) {
+            work(*item);
+          } else {
+            std::this_thread::yield();
+          }
+        }
+      }});
+    }
+    for (int i{}; i < items; ++i) {
+      deque.push(i);
+      if (i % 2 == 0) {
+        if (std::optional<int> item{deque.pop()}) {
+          work(*item);
+        }
+      }
+    }
+    while (std::optional<int> item{deque.pop()}) {
+      work(*item);
+    }
+    for (std::thread& thread : thieves) {
+      thread.join();
+    }
+    double elapsed{timer.elapsed()};
+    std::cout << threadCount << " THREADS: " << items / elapsed
+              << " items/s\n";
+    EXPECT_EQ(sum.load(), static_cast<long long>(items) * (items - 1) / 2);
+  }
+}